@@ -26,6 +26,7 @@
 #include <cstdlib>
 
 #include "utilities/CArgs.h"
+#include "utilities/CCheckpoint.h"
 
 #include "diseaseModel/CModel.h"
 #include "plugins/CPlugin.h"
@@ -37,6 +38,8 @@
 #include "utilities/CLogger.h"
 #include "db/CSchema.h"
 #include "db/CConnection.h"
+#include "db/CMemoryDB.h"
+#include "db/CQueryCache.h"
 #include "utilities/CSimConfig.h"
 #include "utilities/CStatus.h"
 #include "actions/CActionQueue.h"
@@ -106,6 +109,12 @@ int main(int argc, char * argv[])
       goto failed;
     }
 
+  if (CArgs::isRestart()
+      && !CCheckpoint::load())
+    {
+      goto failed;
+    }
+
   CNetwork::init();
 
   if (CLogger::hasErrors())
@@ -174,6 +183,14 @@ int main(int argc, char * argv[])
 
   CNetwork::Context.Master().load();
 
+  if (CLogger::hasErrors())
+    {
+      goto failed;
+    }
+
+  CMemoryDB::load(CSimConfig::getPersonTraitDB());
+  CQueryCache::init();
+
   if (CLogger::hasErrors())
     {
       goto failed;
@@ -208,6 +225,8 @@ success:
   CComputable::Instances.clear();
   CNetwork::clear();
   CConnection::clear();
+  CMemoryDB::clear();
+  CQueryCache::clear();
   CActionQueue::clear();
   CSimConfig::clear();
   CCommunicate::finalize();
@@ -0,0 +1,108 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "actions/CTransitionBlock.h"
+
+void printUsage(const char * name)
+{
+  std::cout << std::endl
+            << "Usage:" << std::endl
+            << "  " << name << " <binary output> [<csv output>]" << std::endl
+            << std::endl
+            << "Converts the binary state transition output of EpiHiper to CSV. The CSV is written" << std::endl
+            << "to standard output if no file is specified." << std::endl
+            << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+  if (argc < 2 || argc > 3)
+    {
+      printUsage(argv[0]);
+      exit(EXIT_FAILURE);
+    }
+
+  std::ifstream is(argv[1], std::ios_base::binary);
+
+  if (is.fail())
+    {
+      std::cerr << "Failed to open file '" << argv[1] << "'." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+
+  std::ofstream File;
+
+  if (argc == 3)
+    {
+      File.open(argv[2]);
+
+      if (File.fail())
+        {
+          std::cerr << "Failed to open file '" << argv[2] << "'." << std::endl;
+          exit(EXIT_FAILURE);
+        }
+    }
+
+  std::ostream & os = (argc == 3) ? File : std::cout;
+
+  std::vector< std::string > States;
+  bool HasLocationId;
+
+  if (!CTransitionBlock::readHeader(is, States, HasLocationId))
+    {
+      std::cerr << "Invalid header in file '" << argv[1] << "'." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+
+  CTransitionBlock::writeCSVHeader(os, HasLocationId);
+
+  CTransitionBlock Block;
+
+  while (is.peek() != std::char_traits< char >::eof())
+    {
+      if (!Block.read(is, HasLocationId))
+        {
+          std::cerr << "Invalid block in file '" << argv[1] << "'." << std::endl;
+          exit(EXIT_FAILURE);
+        }
+
+      Block.toCSV(os, States, HasLocationId);
+    }
+
+  os.flush();
+
+  if (os.fail())
+    {
+      std::cerr << "Failed to write CSV." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+
+  exit(EXIT_SUCCESS);
+}
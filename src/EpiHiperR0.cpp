@@ -33,6 +33,8 @@
 #include "utilities/CLogger.h"
 #include "db/CSchema.h"
 #include "db/CConnection.h"
+#include "db/CMemoryDB.h"
+#include "db/CQueryCache.h"
 #include "utilities/CSimConfig.h"
 #include "utilities/CStatus.h"
 #include "actions/CActionQueue.h"
@@ -162,6 +164,14 @@ int main(int argc, char * argv[])
 
   CNetwork::Context.Active().load();
 
+  if (CLogger::hasErrors())
+    {
+      goto failed;
+    }
+
+  CMemoryDB::load(CSimConfig::getPersonTraitDB());
+  CQueryCache::init();
+
   if (CLogger::hasErrors())
     {
       goto failed;
@@ -193,6 +203,8 @@ success:
   CIntervention::clear();
   CNetwork::clear();
   CConnection::clear();
+  CMemoryDB::clear();
+  CQueryCache::clear();
   CActionQueue::clear();
   CSimConfig::clear();
   CCommunicate::finalize();
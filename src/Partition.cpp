@@ -41,8 +41,11 @@
 std::string ContactNetwork;
 std::string OutputDirectory;
 std::string Status;
+std::string PartitionMethod("edgeCount");
 
 int Parts(std::numeric_limits< int >::min());
+double MaxImbalance(0.05);
+bool ReorderNodes(false);
 
 bool loadJson(const std::string & file)
 {
@@ -67,6 +70,20 @@ bool loadJson(const std::string & file)
       "minimum": 0,
       "multipleOf": 1.0
     },
+    "partitionMethod": {
+      "description": "The method used to create the parts. 'edgeCount' splits the network into contiguous target ranges with balanced edge count. 'minimumCut' minimizes the edges between parts and relabels the nodes (Default: edgeCount).",
+      "type": "string",
+      "enum": ["edgeCount", "minimumCut"]
+    },
+    "maxImbalance": {
+      "description": "The relative amount the edge count of a part may exceed the average for the method 'minimumCut' (Default: 0.05).",
+      "type": "number",
+      "minimum": 0
+    },
+    "reorderNodes": {
+      "description": "Order the nodes within each part by reverse Cuthill-McKee to place contacts close in memory. Requires the method 'minimumCut' (Default: false).",
+      "type": "boolean"
+    },
     "outputDirectory": {
       "description": "Output Directory for the created parts",
       "default": "/output",
@@ -109,6 +126,33 @@ bool loadJson(const std::string & file)
 
   success &= Parts != std::numeric_limits< int >::min();
 
+  pValue = json_object_get(pRoot, "partitionMethod");
+
+  if (json_is_string(pValue))
+    {
+      PartitionMethod = json_string_value(pValue);
+    }
+
+  success &= (PartitionMethod == "edgeCount" || PartitionMethod == "minimumCut");
+
+  pValue = json_object_get(pRoot, "maxImbalance");
+
+  if (json_is_real(pValue))
+    {
+      MaxImbalance = json_real_value(pValue);
+    }
+
+  success &= MaxImbalance >= 0.0;
+
+  pValue = json_object_get(pRoot, "reorderNodes");
+
+  if (json_is_boolean(pValue))
+    {
+      ReorderNodes = json_boolean_value(pValue);
+    }
+
+  success &= (!ReorderNodes || PartitionMethod == "minimumCut");
+
   std::string DefaultDir;
 
   if (CDirEntry::exist("/output")
@@ -189,7 +233,11 @@ int main(int argc, char * argv[])
   CTrait::init();
   CNetwork All;
   All.loadJsonPreamble(ContactNetwork);
-  All.partition(Parts, true, OutputDirectory);
+
+  if (PartitionMethod == "minimumCut")
+    All.partitionMinimumCut(Parts, MaxImbalance, ReorderNodes, OutputDirectory);
+  else
+    All.partition(Parts, true, OutputDirectory);
 
   if (CLogger::hasErrors())
     {
@@ -23,10 +23,193 @@
 // END: Copyright 
 
 #include "actions/CAction.h"
+#include "actions/CNodeAction.h"
+#include "actions/CEdgeAction.h"
+#include "actions/CVariableAction.h"
+#include "actions/CProgressionAction.h"
+#include "actions/CTransmissionAction.h"
+#include "utilities/CLogger.h"
 
 // static
 size_t CAction::DefaultOrder = 0;
 
+// static
+CContext< CAction::sPool > CAction::Pools;
+
+CAction::sPool::sPool()
+  : pCurrent(NULL)
+  , pEnd(NULL)
+  , Slabs()
+  , Allocations(0)
+  , Releases(0)
+{
+  for (size_t i = 0; i < PoolClasses; ++i)
+    {
+      FreeList[i] = NULL;
+      Returned[i] = NULL;
+    }
+}
+
+// static
+void * CAction::operator new(size_t size)
+{
+  size_t Class = (size + sizeof(sPoolHeader) + PoolGranularity - 1) / PoolGranularity;
+
+  if (Pools.size() == 0
+      || Class >= PoolClasses)
+    {
+      sPoolHeader * pHeader = static_cast< sPoolHeader * >(::operator new(size + sizeof(sPoolHeader)));
+      pHeader->pOwner = NULL;
+
+      return pHeader + 1;
+    }
+
+  sPool & Pool = Pools.Active();
+  ++Pool.Allocations;
+
+  sPoolFree * pFree = Pool.FreeList[Class];
+
+  // Collect the memory released by other threads.
+  if (pFree == NULL)
+    pFree = Pool.Returned[Class].exchange(NULL, std::memory_order_acquire);
+
+  sPoolHeader * pHeader = NULL;
+
+  if (pFree != NULL)
+    {
+      Pool.FreeList[Class] = pFree->pNext;
+      pHeader = reinterpret_cast< sPoolHeader * >(pFree);
+    }
+  else
+    {
+      size_t Size = Class * PoolGranularity;
+
+      if (Pool.pCurrent + Size > Pool.pEnd)
+        {
+          Pool.pCurrent = new char[PoolSlabSize];
+          Pool.pEnd = Pool.pCurrent + PoolSlabSize;
+          Pool.Slabs.push_back(Pool.pCurrent);
+        }
+
+      pHeader = reinterpret_cast< sPoolHeader * >(Pool.pCurrent);
+      Pool.pCurrent += Size;
+    }
+
+  pHeader->pOwner = &Pool;
+
+  return pHeader + 1;
+}
+
+// static
+void CAction::operator delete(void * ptr, size_t size)
+{
+  if (ptr == NULL)
+    return;
+
+  sPoolHeader * pHeader = static_cast< sPoolHeader * >(ptr) - 1;
+  sPool * pOwner = pHeader->pOwner;
+
+  if (pOwner == NULL)
+    {
+      ::operator delete(pHeader);
+      return;
+    }
+
+  size_t Class = (size + sizeof(sPoolHeader) + PoolGranularity - 1) / PoolGranularity;
+  sPoolFree * pFree = reinterpret_cast< sPoolFree * >(pHeader);
+
+  sPool & Pool = Pools.Active();
+  ++Pool.Releases;
+
+  if (pOwner == &Pool)
+    {
+      pFree->pNext = Pool.FreeList[Class];
+      Pool.FreeList[Class] = pFree;
+      return;
+    }
+
+  // The memory was allocated by another thread and is returned to its owner.
+  pFree->pNext = pOwner->Returned[Class].load(std::memory_order_relaxed);
+
+  while (!pOwner->Returned[Class].compare_exchange_weak(pFree->pNext, pFree, std::memory_order_release, std::memory_order_relaxed))
+    continue;
+}
+
+// static
+void CAction::initPools()
+{
+  Pools.init();
+}
+
+// static
+void CAction::releasePool(CAction::sPool & pool)
+{
+  std::vector< char * >::iterator it = pool.Slabs.begin();
+  std::vector< char * >::iterator end = pool.Slabs.end();
+
+  for (; it != end; ++it)
+    delete [] *it;
+
+  for (size_t i = 0; i < PoolClasses; ++i)
+    {
+      pool.FreeList[i] = NULL;
+      pool.Returned[i] = NULL;
+    }
+
+  pool.pCurrent = NULL;
+  pool.pEnd = NULL;
+  pool.Slabs.clear();
+  pool.Allocations = 0;
+  pool.Releases = 0;
+}
+
+// static
+void CAction::releasePools()
+{
+  if (Pools.size() == 0)
+    return;
+
+  releasePool(Pools.Master());
+
+  sPool * pIt = Pools.beginThread();
+  sPool * pEnd = Pools.endThread();
+
+  for (; pIt != pEnd; ++pIt)
+    if (Pools.isThread(pIt))
+      releasePool(*pIt);
+
+  Pools.release();
+}
+
+// static
+void CAction::poolUsage(size_t & live, size_t & allocations, size_t & reserved)
+{
+  live = 0;
+  allocations = 0;
+  reserved = 0;
+
+  if (Pools.size() == 0)
+    return;
+
+  // Memory is released by the thread executing the action, i.e., only the sum is meaningful.
+  size_t Releases = Pools.Master().Releases;
+  allocations = Pools.Master().Allocations;
+  reserved = Pools.Master().Slabs.size() * PoolSlabSize;
+
+  const sPool * pIt = Pools.beginThread();
+  const sPool * pEnd = Pools.endThread();
+
+  for (; pIt != pEnd; ++pIt)
+    if (Pools.isThread(pIt))
+      {
+        Releases += pIt->Releases;
+        allocations += pIt->Allocations;
+        reserved += pIt->Slabs.size() * PoolSlabSize;
+      }
+
+  live = allocations - Releases;
+}
+
 // static
 void CAction::setDefaultOrder(const size_t & defaultOrder)
 {
@@ -38,3 +221,35 @@ CAction::CAction()
 
 CAction::~CAction()
 {}
+
+// static
+CAction * CAction::fromBinary(std::istream & is)
+{
+  char Type;
+  is.read(&Type, sizeof(char));
+
+  if (is.fail())
+    return NULL;
+
+  switch (Type)
+    {
+    case 'N':
+      return CNodeAction::fromBinary(is);
+
+    case 'E':
+      return CEdgeAction::fromBinary(is);
+
+    case 'V':
+      return CVariableAction::fromBinary(is);
+
+    case 'P':
+      return CProgressionAction::fromBinary(is);
+
+    case 'T':
+      return CTransmissionAction::fromBinary(is);
+    }
+
+  CLogger::error("CAction: Invalid action type '{}'.", Type);
+
+  return NULL;
+}
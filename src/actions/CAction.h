@@ -26,15 +26,92 @@
 #define SRC_ACTIONS_CSCHEDULEDACTION_H_
 
 #include <stddef.h>
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+#include "utilities/CContext.h"
 
 class CAction
 {
+private:
+  static const size_t PoolGranularity = 16;
+  static const size_t PoolClasses = 16;
+  static const size_t PoolSlabSize = 1 << 16;
+
+  struct sPoolFree
+  {
+    sPoolFree * pNext;
+  };
+
+  struct sPool
+  {
+    sPool();
+
+    sPoolFree * FreeList[PoolClasses];
+    std::atomic< sPoolFree * > Returned[PoolClasses];
+    char * pCurrent;
+    char * pEnd;
+    std::vector< char * > Slabs;
+    size_t Allocations;
+    size_t Releases;
+  };
+
+  /**
+   * Each block starts with a header of PoolGranularity bytes holding the owning pool (NULL if the
+   * block was not allocated from a pool).
+   */
+  union sPoolHeader
+  {
+    sPool * pOwner;
+    char Padding[PoolGranularity];
+  };
+
+  static CContext< sPool > Pools;
+
+  static void releasePool(sPool & pool);
+
 protected:
   CAction();
 
   static size_t DefaultOrder;
 
 public:
+  /**
+   * Allocate the memory for an action from the pool of the active thread. Freed memory is
+   * kept in per thread free lists and reused by the following allocations. Memory released
+   * by other threads is collected from the pool's return list when the free list is empty.
+   * @param size_t size
+   * @return void * ptr
+   */
+  static void * operator new(size_t size);
+
+  /**
+   * Return the memory of an action to the pool which allocated it. If this is not the pool of the
+   * active thread the memory is pushed onto the owner's return list.
+   * @param void * ptr
+   * @param size_t size
+   */
+  static void operator delete(void * ptr, size_t size);
+
+  /**
+   * Initialize the per thread action pools. This must be called outside of a parallel region.
+   */
+  static void initPools();
+
+  /**
+   * Release the memory of all action pools. All actions must have been destroyed.
+   */
+  static void releasePools();
+
+  /**
+   * Retrieve the statistics of the action pools accumulated over all threads
+   * @param size_t & live
+   * @param size_t & allocations
+   * @param size_t & reserved
+   */
+  static void poolUsage(size_t & live, size_t & allocations, size_t & reserved);
+
   static void setDefaultOrder(const size_t & defaultOrder);
 
   CAction(const CAction & src) = delete;
@@ -44,6 +121,19 @@ public:
   virtual size_t getOrder() const = 0;
 
   virtual bool execute() const = 0;
+
+  /**
+   * Write the action to a checkpoint. The first character identifies the type of the action.
+   * @param std::ostream & os
+   */
+  virtual void toBinary(std::ostream & os) const = 0;
+
+  /**
+   * Create an action from its checkpoint representation.
+   * @param std::istream & is
+   * @return CAction * pAction (NULL on failure)
+   */
+  static CAction * fromBinary(std::istream & is);
 };
 
 #endif // SRC_ACTIONS_CSCHEDULEDACTION_H_
\ No newline at end of file
@@ -0,0 +1,217 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include "actions/CActionCalendar.h"
+
+// static
+const size_t CActionCalendar::Horizon = 256;
+
+CActionCalendar::CActionCalendar()
+  : mRing(Horizon, NULL)
+  , mTicks(Horizon, 0)
+  , mOverflow()
+  , mFirst(0)
+  , mpSpare(NULL)
+{}
+
+CActionCalendar::~CActionCalendar()
+{
+  std::vector< CCurrentActions * >::iterator it = mRing.begin();
+  std::vector< CCurrentActions * >::iterator end = mRing.end();
+
+  for (; it != end; ++it)
+    if (*it != NULL)
+      delete *it;
+
+  std::map< size_t, CCurrentActions * >::iterator itOverflow = mOverflow.begin();
+  std::map< size_t, CCurrentActions * >::iterator endOverflow = mOverflow.end();
+
+  for (; itOverflow != endOverflow; ++itOverflow)
+    delete itOverflow->second;
+
+  if (mpSpare != NULL)
+    delete mpSpare;
+}
+
+CCurrentActions * CActionCalendar::create()
+{
+  CCurrentActions * pActions = mpSpare;
+
+  if (pActions != NULL)
+    mpSpare = NULL;
+  else
+    pActions = new CCurrentActions();
+
+  return pActions;
+}
+
+CCurrentActions & CActionCalendar::at(const size_t & tick)
+{
+  if (tick >= mFirst + Horizon)
+    {
+      CCurrentActions *& pActions = mOverflow[tick];
+
+      if (pActions == NULL)
+        pActions = create();
+
+      return *pActions;
+    }
+
+  size_t Slot = tick % Horizon;
+  CCurrentActions *& pActions = mRing[Slot];
+
+  if (pActions == NULL)
+    {
+      pActions = create();
+      mTicks[Slot] = tick;
+    }
+  else if (mTicks[Slot] != tick)
+    {
+      // The slot still holds a tick which has passed without being processed.
+      pActions->reset();
+      mTicks[Slot] = tick;
+    }
+
+  return *pActions;
+}
+
+const CCurrentActions * CActionCalendar::find(const size_t & tick) const
+{
+  size_t Slot = tick % Horizon;
+
+  if (mRing[Slot] != NULL
+      && mTicks[Slot] == tick)
+    return mRing[Slot];
+
+  std::map< size_t, CCurrentActions * >::const_iterator found = mOverflow.find(tick);
+
+  if (found != mOverflow.end())
+    return found->second;
+
+  return NULL;
+}
+
+size_t CActionCalendar::size(const size_t & tick) const
+{
+  const CCurrentActions * pActions = find(tick);
+
+  return pActions != NULL ? pActions->size() : 0;
+}
+
+void CActionCalendar::advance(const size_t & first)
+{
+  mFirst = first;
+
+  while (!mOverflow.empty()
+         && mOverflow.begin()->first < mFirst + Horizon)
+    {
+      size_t Tick = mOverflow.begin()->first;
+      CCurrentActions * pActions = mOverflow.begin()->second;
+      mOverflow.erase(mOverflow.begin());
+
+      size_t Slot = Tick % Horizon;
+
+      if (mRing[Slot] != NULL)
+        recycle(mRing[Slot]);
+
+      mRing[Slot] = pActions;
+      mTicks[Slot] = Tick;
+    }
+}
+
+CCurrentActions * CActionCalendar::take(const size_t & tick)
+{
+  CCurrentActions * pActions = &at(tick);
+
+  if (tick < mFirst + Horizon)
+    mRing[tick % Horizon] = NULL;
+  else
+    mOverflow.erase(tick);
+
+  return pActions;
+}
+
+void CActionCalendar::recycle(CCurrentActions * pActions)
+{
+  pActions->reset();
+
+  if (mpSpare == NULL)
+    mpSpare = pActions;
+  else
+    delete pActions;
+}
+
+void CActionCalendar::toBinary(std::ostream & os, const size_t & first) const
+{
+  size_t End = first;
+
+  for (size_t Slot = 0; Slot < Horizon; ++Slot)
+    if (mRing[Slot] != NULL
+        && mTicks[Slot] >= End
+        && mRing[Slot]->size() > 0)
+      End = mTicks[Slot] + 1;
+
+  std::map< size_t, CCurrentActions * >::const_reverse_iterator itOverflow = mOverflow.rbegin();
+  std::map< size_t, CCurrentActions * >::const_reverse_iterator endOverflow = mOverflow.rend();
+
+  for (; itOverflow != endOverflow; ++itOverflow)
+    if (itOverflow->second->size() > 0)
+      {
+        if (itOverflow->first >= End)
+          End = itOverflow->first + 1;
+
+        break;
+      }
+
+  size_t Size = End - first;
+  os.write(reinterpret_cast< const char * >(&Size), sizeof(size_t));
+
+  CCurrentActions Empty;
+
+  for (size_t Tick = first; Tick < End; ++Tick)
+    {
+      const CCurrentActions * pActions = find(Tick);
+
+      if (pActions != NULL)
+        pActions->toBinary(os);
+      else
+        Empty.toBinary(os);
+    }
+}
+
+bool CActionCalendar::fromBinary(std::istream & is, const size_t & first)
+{
+  size_t Size;
+  is.read(reinterpret_cast< char * >(&Size), sizeof(size_t));
+
+  if (is.fail())
+    return false;
+
+  bool success = true;
+
+  for (size_t i = 0; i < Size && success; ++i)
+    success &= at(first + i).fromBinary(is);
+
+  return success;
+}
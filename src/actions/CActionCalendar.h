@@ -0,0 +1,111 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_ACTIONS_CACTIONCALENDAR_H_
+#define SRC_ACTIONS_CACTIONCALENDAR_H_
+
+#include <map>
+#include <vector>
+#include <iostream>
+
+#include "actions/CCurrentActions.h"
+
+/**
+ * The actions scheduled for the ticks of a thread. The ticks within a fixed horizon
+ * starting with the first pending tick are kept in a ring indexed by tick mod horizon.
+ * Actions scheduled beyond the horizon are kept in an ordered overflow and moved into
+ * the ring when the calendar advances. The storage of processed ticks is reused.
+ */
+class CActionCalendar
+{
+public:
+  static const size_t Horizon;
+
+  CActionCalendar();
+
+  CActionCalendar(const CActionCalendar & src) = delete;
+
+  ~CActionCalendar();
+
+  /**
+   * Retrieve the actions scheduled for the given tick
+   * @param const size_t & tick
+   * @return CCurrentActions & actions
+   */
+  CCurrentActions & at(const size_t & tick);
+
+  /**
+   * Retrieve the number of actions scheduled for the given tick
+   * @param const size_t & tick
+   * @return size_t size
+   */
+  size_t size(const size_t & tick) const;
+
+  /**
+   * Advance the calendar so that the given tick is the first pending tick
+   * @param const size_t & first
+   */
+  void advance(const size_t & first);
+
+  /**
+   * Remove the actions of the given tick from the calendar. Actions added afterwards
+   * for the tick are kept in a new container.
+   * @param const size_t & tick
+   * @return CCurrentActions * pActions
+   */
+  CCurrentActions * take(const size_t & tick);
+
+  /**
+   * Destroy the actions of a container returned by take and keep its storage for reuse.
+   * @param CCurrentActions * pActions
+   */
+  void recycle(CCurrentActions * pActions);
+
+  /**
+   * Write the actions scheduled starting with the given tick
+   * @param std::ostream & os
+   * @param const size_t & first
+   */
+  void toBinary(std::ostream & os, const size_t & first) const;
+
+  /**
+   * Restore the actions scheduled starting with the given tick
+   * @param std::istream & is
+   * @param const size_t & first
+   * @return bool success
+   */
+  bool fromBinary(std::istream & is, const size_t & first);
+
+private:
+  CCurrentActions * create();
+  const CCurrentActions * find(const size_t & tick) const;
+
+  std::vector< CCurrentActions * > mRing;
+  std::vector< size_t > mTicks;
+  std::map< size_t, CCurrentActions * > mOverflow;
+  size_t mFirst;
+  CCurrentActions * mpSpare;
+};
+
+#endif /* SRC_ACTIONS_CACTIONCALENDAR_H_ */
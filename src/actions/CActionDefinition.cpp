@@ -302,7 +302,7 @@ void CActionDefinition::process(const CEdge * pEdge) const
   if (pEdge == NULL)
     return;
 
-  if (CNetwork::Context.Active().isRemoteNode(pEdge->pTarget))
+  if (CNetwork::Context.Active().isRemoteNode(pEdge->target()))
     {
       CLogger::warn("CActionDefinition::process: [ActionDefinition: {}] Add remote action for edge '{}, {}'.", mIndex, pEdge->targetId, pEdge->sourceId);
       CActionQueue::addRemoteAction(mIndex, pEdge);
@@ -428,3 +428,8 @@ size_t CActionDefinition::getOrder() const
 {
   return mOrder;
 }
+
+const size_t & CActionDefinition::getIndex() const
+{
+  return mIndex;
+}
@@ -67,6 +67,8 @@ public:
   
   size_t getOrder() const;
 
+  const size_t & getIndex() const;
+
   static CActionDefinition * GetActionDefinition(const size_t & index);
 
   static void clear();
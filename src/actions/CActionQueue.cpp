@@ -22,6 +22,8 @@
 // SOFTWARE 
 // END: Copyright 
 
+#include <algorithm>
+
 #include "actions/CActionQueue.h"
 #include "actions/CActionDefinition.h"
 #include "actions/CNodeAction.h"
@@ -38,6 +40,16 @@ size_t CActionQueue::Offset = 0;
 void CActionQueue::init(const int & firstTick)
 {
   Context.init();
+  CAction::initPools();
+
+  Context.Master().localActions.resize(Context.size());
+
+  sActionQueue * pActionQueue = Context.beginThread();
+  sActionQueue * pEndActionQueue = Context.endThread();
+
+  for (; pActionQueue != pEndActionQueue; ++pActionQueue)
+    if (Context.isThread(pActionQueue))
+      pActionQueue->localActions.resize(Context.size());
 
   Offset = -firstTick;
   setCurrentTick(firstTick);
@@ -48,39 +60,37 @@ void CActionQueue::clear()
 {
   if (Context.size())
     {
-      queue::iterator itAction = Context.Master().actionQueue.begin();
-      queue::iterator endAction = Context.Master().actionQueue.end();
-
-      for (; itAction != endAction; ++itAction)
-        delete *itAction;
-
-      queue::iterator itLocal = Context.Master().locallyAdded.begin();
-      queue::iterator endLocal = Context.Master().locallyAdded.end();
-
-      for (; itLocal != endLocal; ++itLocal)
-        delete *itLocal;
+      deleteLocalActions(Context.Master());
 
       sActionQueue * pActionQueue = Context.beginThread();
       sActionQueue * pEndActionQueue = Context.endThread();
 
       for (; pActionQueue != pEndActionQueue; ++pActionQueue)
         if (Context.isThread(pActionQueue))
-          {
-            queue::iterator itAction = pActionQueue->actionQueue.begin();
-            queue::iterator endAction = pActionQueue->actionQueue.end();
+          deleteLocalActions(*pActionQueue);
+    }
 
-            for (; itAction != endAction; ++itAction)
-              delete *itAction;
+  // The calendars destroy all scheduled actions.
+  Context.release();
+  CAction::releasePools();
+}
 
-            queue::iterator itLocal = pActionQueue->locallyAdded.begin();
-            queue::iterator endLocal = pActionQueue->locallyAdded.end();
+// static
+void CActionQueue::deleteLocalActions(CActionQueue::sActionQueue & actionQueue)
+{
+  std::vector< std::vector< sLocalAction > >::iterator itThread = actionQueue.localActions.begin();
+  std::vector< std::vector< sLocalAction > >::iterator endThread = actionQueue.localActions.end();
 
-            for (; itLocal != endLocal; ++itLocal)
-              delete *itLocal;
-          }
-    }
+  for (; itThread != endThread; ++itThread)
+    {
+      std::vector< sLocalAction >::iterator it = itThread->begin();
+      std::vector< sLocalAction >::iterator end = itThread->end();
 
-  Context.release();
+      for (; it != end; ++it)
+        delete it->pAction;
+
+      itThread->clear();
+    }
 }
 
 // static
@@ -99,19 +109,22 @@ void CActionQueue::addAction(size_t deltaTick, CAction * pAction)
 // static 
 void CActionQueue::addAction(CActionQueue::queue & queue, size_t deltaTick, CAction * pAction)
 {
-  at(CurrenTick + deltaTick, queue)->addAction(pAction);
+  at(CurrenTick + deltaTick, queue).addAction(pAction);
 }
 
 // static
 bool CActionQueue::processCurrentActions()
 {
   bool success = true;
+  queue & ActionQueue = Context.Active().actionQueue;
 
   // We need to enter the loop at least once
   do
     {
-      queue::value_type pActions = at(CurrenTick, Context.Active().actionQueue);
-      at(CurrenTick, Context.Active().actionQueue) = new CCurrentActions();
+      size_t Current = CurrenTick + Offset;
+
+      ActionQueue.advance(Current);
+      CCurrentActions * pActions = ActionQueue.take(Current);
 
       CCurrentActions::iterator it = pActions->begin();
       CCurrentActions::iterator end = pActions->end();
@@ -119,7 +132,7 @@ bool CActionQueue::processCurrentActions()
       for (; it != end; it.next())
         success &= it->execute();
 
-      delete pActions;
+      ActionQueue.recycle(pActions);
 
       CCommunicate::barrierRMA();
 
@@ -137,7 +150,7 @@ bool CActionQueue::processCurrentActions()
 // static
 size_t CActionQueue::pendingActions()
 {
-  return at(CurrenTick, Context.Active().actionQueue)->size();
+  return Context.Active().actionQueue.size(CurrenTick + Offset);
 }
 
 // static
@@ -169,12 +182,11 @@ void CActionQueue::addRemoteAction(const size_t & actionId, const CNode * pNode)
     {
       try
         {
-#pragma omp critical (add_remote_action)
-          {
-            RemoteActions.write(reinterpret_cast< const char * >(&actionId), sizeof(size_t));
-            RemoteActions << 'N';
-            RemoteActions.write(reinterpret_cast< const char * >(&pNode->id), sizeof(size_t));
-          }
+          std::string & RemoteActions = Context.Active().remoteActions;
+
+          RemoteActions.append(reinterpret_cast< const char * >(&actionId), sizeof(size_t));
+          RemoteActions += 'N';
+          RemoteActions.append(reinterpret_cast< const char * >(&pNode->id), sizeof(size_t));
         }
       catch (...)
         {
@@ -184,37 +196,29 @@ void CActionQueue::addRemoteAction(const size_t & actionId, const CNode * pNode)
   else
     {
       CActionDefinition * pActionDefinition = CActionDefinition::GetActionDefinition(actionId);
-      size_t deltaTick = pActionDefinition->getDelay();
-      CAction * pAction = new CNodeAction(pActionDefinition, pNode);
-
-      try
-        {
-#pragma omp critical (add_local_action)
-          addAction((Context.beginThread() + index)->locallyAdded, deltaTick, pAction);
-        }
-      catch (...)
-        {
-          CLogger::error("CActionQueue: Failed to add action.");
-        }
+      addLocalAction(index, pActionDefinition->getDelay(), new CNodeAction(pActionDefinition, pNode));
     }
 }
 
 // static
 void CActionQueue::addRemoteAction(const size_t & actionId, const CEdge * pEdge)
 {
-  int index = CNetwork::index(pEdge->pTarget);
+  int index = CNetwork::index(pEdge->target());
 
   if (index < 0)
     {
       try
         {
-#pragma omp critical (add_remote_action)
-          {
-            RemoteActions.write(reinterpret_cast< const char * >(&actionId), sizeof(size_t));
-            RemoteActions << 'E';
-            RemoteActions.write(reinterpret_cast< const char * >(&pEdge->targetId), sizeof(size_t));
-            RemoteActions.write(reinterpret_cast< const char * >(&pEdge->sourceId), sizeof(size_t));
-          }
+          std::string & RemoteActions = Context.Active().remoteActions;
+
+          RemoteActions.append(reinterpret_cast< const char * >(&actionId), sizeof(size_t));
+          RemoteActions += 'E';
+          RemoteActions.append(reinterpret_cast< const char * >(&pEdge->targetId), sizeof(size_t));
+          RemoteActions.append(reinterpret_cast< const char * >(&pEdge->sourceId), sizeof(size_t));
+
+          // The position within the edges of the target identifies the edge uniquely.
+          size_t EdgeOffset = pEdge - pEdge->target()->Edges;
+          RemoteActions.append(reinterpret_cast< const char * >(&EdgeOffset), sizeof(size_t));
         }
       catch (...)
         {
@@ -224,49 +228,53 @@ void CActionQueue::addRemoteAction(const size_t & actionId, const CEdge * pEdge)
   else
     {
       CActionDefinition * pActionDefinition = CActionDefinition::GetActionDefinition(actionId);
-      size_t deltaTick = pActionDefinition->getDelay();
-      CAction * pAction = new CEdgeAction(pActionDefinition, pEdge);
-
-      try
-        {
-#pragma omp critical (add_local_action)
-          addAction((Context.beginThread() + index)->locallyAdded, deltaTick, pAction);
-        }
-      catch (...)
-        {
-          CLogger::error("CActionQueue: Failed to add action.");
-        }
+      addLocalAction(index, pActionDefinition->getDelay(), new CEdgeAction(pActionDefinition, pEdge));
     }
 }
 
 // static
-int CActionQueue::broadcastPendingActions()
+void CActionQueue::addLocalAction(const int & index, size_t deltaTick, CAction * pAction)
 {
-  sActionQueue & ActionQueue = Context.Active();
-  queue::iterator it = ActionQueue.locallyAdded.begin();
-  queue::iterator end = ActionQueue.locallyAdded.end();
+  try
+    {
+      Context.Active().localActions[index].push_back({CurrenTick + deltaTick, pAction});
+    }
+  catch (...)
+    {
+      CLogger::error("CActionQueue: Failed to add action.");
+    }
+}
 
-  size_t Tick = -Offset;
+// static
+void CActionQueue::collectLocalActions(CActionQueue::sActionQueue & source, CActionQueue::sActionQueue & target, const int & index)
+{
+  std::vector< sLocalAction > & LocalActions = source.localActions[index];
+  std::vector< sLocalAction >::const_iterator it = LocalActions.begin();
+  std::vector< sLocalAction >::const_iterator end = LocalActions.end();
 
-  for (; it != end; ++it, ++Tick)
-    {
-      CCurrentActions::iterator itAction = (*it)->begin(false);
-      CCurrentActions::iterator endAction = (*it)->end(false);
+  for (; it != end; ++it)
+    at(it->tick, target.actionQueue).addAction(it->pAction);
 
-      for (; itAction != endAction; itAction.next())
-        addAction(Tick - CurrenTick, const_cast< CAction * >(*itAction));
+  LocalActions.clear();
+}
 
-      (*it)->clear();
-    }
+// static
+int CActionQueue::broadcastPendingActions()
+{
+  // Collect the actions other threads added for this thread. All threads have passed the barrier in
+  // CCommunicate::barrierRMA, i.e., the outbound buffers are no longer modified.
+  sActionQueue & ActionQueue = Context.Active();
+  int Index = std::max(Context.localIndex(&ActionQueue), 0);
 
-  ActionQueue.locallyAdded.clear();
-  size_t PendingActions = pendingActions();
+  // The master may have added actions outside of a parallel region.
+  collectLocalActions(Context.Master(), ActionQueue, Index);
 
-#pragma omp single
-  TotalPendingActions = 0;
+  sActionQueue * pSource = Context.beginThread();
+  sActionQueue * pEndSource = Context.endThread();
 
-#pragma omp atomic
-  TotalPendingActions += PendingActions;
+  for (; pSource != pEndSource; ++pSource)
+    if (Context.isThread(pSource))
+      collectLocalActions(*pSource, ActionQueue, Index);
 
 #pragma omp barrier
 #pragma omp single
@@ -274,15 +282,33 @@ int CActionQueue::broadcastPendingActions()
     CLogger::setSingle(true);
   
     std::ostringstream os;
-    os.write(reinterpret_cast< const char * >(&TotalPendingActions), sizeof(size_t));
-    os << RemoteActions.str();
-    RemoteActions.str("");
+    os << Context.Master().remoteActions;
+    Context.Master().remoteActions.clear();
+
+    sActionQueue * pActionQueue = Context.beginThread();
+    sActionQueue * pEndActionQueue = Context.endThread();
+
+    for (; pActionQueue != pEndActionQueue; ++pActionQueue)
+      if (Context.isThread(pActionQueue))
+        {
+          os << pActionQueue->remoteActions;
+          pActionQueue->remoteActions.clear();
+        }
 
     const std::string & Buffer = os.str();
 
     CCommunicate::Receive Receive(&CActionQueue::receivePendingActions);
     CCommunicate::roundRobin(Buffer.c_str(), Buffer.length(), &Receive);
 
+    // The received actions are pending on this rank, i.e., the pending actions are counted after the
+    // exchange and summed over all ranks so that all ranks agree whether to continue.
+    TotalPendingActions = 0;
+
+    for (pActionQueue = Context.beginThread(); pActionQueue != pEndActionQueue; ++pActionQueue)
+      TotalPendingActions += pActionQueue->actionQueue.size(CurrenTick + Offset);
+
+    CCommunicate::allreduceSum(&TotalPendingActions, 1);
+
     CLogger::setSingle(false);
   }
   
@@ -291,11 +317,6 @@ int CActionQueue::broadcastPendingActions()
 
 CCommunicate::ErrorCode CActionQueue::receivePendingActions(std::istream & is, int /* sender */)
 {
-  size_t RemotePendingActions;
-
-  is.read(reinterpret_cast< char * >(&RemotePendingActions), sizeof(size_t));
-  TotalPendingActions += RemotePendingActions;
-
   // Check whether we received actions from remote;
   while (true)
     {
@@ -344,8 +365,6 @@ CCommunicate::ErrorCode CActionQueue::receivePendingActions(std::istream & is, i
                   {
                     CLogger::error("CActionQueue: Failed to add action.");
                   }
-
-                ++TotalPendingActions;
               }
           }
 
@@ -358,7 +377,15 @@ CCommunicate::ErrorCode CActionQueue::receivePendingActions(std::istream & is, i
             if (is.fail())
               break;
 
-            CEdge * pEdge = (CNetwork::Context.beginThread() + Index)->lookupEdge(NodeId, SourceId);
+            size_t EdgeOffset;
+            is.read(reinterpret_cast< char * >(&EdgeOffset), sizeof(size_t));
+            if (is.fail())
+              break;
+
+            CEdge * pEdge = NULL;
+
+            if (Index >= 0)
+              pEdge = (CNetwork::Context.beginThread() + Index)->lookupEdge(NodeId, SourceId, EdgeOffset);
 
             if (pEdge != NULL
                 && pActionDefinition != NULL)
@@ -374,8 +401,6 @@ CCommunicate::ErrorCode CActionQueue::receivePendingActions(std::istream & is, i
                   {
                     CLogger::error("CActionQueue: Failed to add action.");
                   }
-
-                ++TotalPendingActions;
               }
           }
           break;
@@ -386,13 +411,19 @@ CCommunicate::ErrorCode CActionQueue::receivePendingActions(std::istream & is, i
 }
 
 // static
-CActionQueue::queue::value_type & CActionQueue::at(size_t index, CActionQueue::queue & queue)
+void CActionQueue::toBinary(std::ostream & os)
 {
-  index += Offset;
+  Context.Active().actionQueue.toBinary(os, CurrenTick + Offset);
+}
 
-  while (queue.size() < index + 1)
-    queue.push_back(new CCurrentActions());
+// static
+bool CActionQueue::fromBinary(std::istream & is)
+{
+  return Context.Active().actionQueue.fromBinary(is, CurrenTick + Offset);
+}
 
-  return  queue.at(index);
+CCurrentActions & CActionQueue::at(size_t index, CActionQueue::queue & queue)
+{
+  return queue.at(index + Offset);
 }
 
@@ -26,10 +26,12 @@
 #define SRC_ACTIONS_CACTIONQUEUE_H_
 
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "utilities/CCommunicate.h"
 #include "utilities/CContext.h"
-#include "actions/CCurrentActions.h"
+#include "actions/CActionCalendar.h"
 #include "math/CTick.h"
 
 class CNode;
@@ -37,7 +39,7 @@ class CEdge;
 
 class CActionQueue
 {
-  typedef std::vector< CCurrentActions * > queue;
+  typedef CActionCalendar queue;
 
   public:
     static void init(const int & firstTick);
@@ -60,26 +62,51 @@ class CActionQueue
 
     static void addRemoteAction(const size_t & index, const CEdge * pEdge);
 
+    /**
+     * Write the actions pending for the active thread starting with the current tick
+     * @param std::ostream & os
+     */
+    static void toBinary(std::ostream & os);
+
+    /**
+     * Restore the actions pending for the active thread starting with the current tick
+     * @param std::istream & is
+     * @return bool success
+     */
+    static bool fromBinary(std::istream & is);
 
   private:
+    struct sLocalAction
+      {
+        size_t tick;
+        CAction * pAction;
+      };
+
     struct sActionQueue
       {
         queue actionQueue;
-        queue locallyAdded;
+        // Outbound buffers written only by the owning thread and merged in broadcastPendingActions
+        std::vector< std::vector< sLocalAction > > localActions;
+        std::string remoteActions;
       };
 
     static int broadcastPendingActions();
 
+    static void addLocalAction(const int & index, size_t deltaTick, CAction * pAction);
+
+    static void collectLocalActions(sActionQueue & source, sActionQueue & target, const int & index);
+
+    static void deleteLocalActions(sActionQueue & actionQueue);
+
     static CCommunicate::ErrorCode receivePendingActions(std::istream & is, int sender);
 
     static CContext< sActionQueue > Context;
     static CTick CurrenTick;
     static size_t TotalPendingActions;
-    static std::stringstream RemoteActions;
     static size_t Offset;
     static void addAction(queue & queue, size_t deltaTick, CAction * pAction);
 
-    static queue::value_type & at(size_t index, CActionQueue::queue & queue);
+    static CCurrentActions & at(size_t index, CActionQueue::queue & queue);
 };
 
 #endif /* SRC_ACTIONS_CACTIONQUEUE_H_ */
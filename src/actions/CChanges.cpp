@@ -30,24 +30,36 @@
  */
 
 #include <fstream>
+#include <algorithm>
+#include <jansson.h>
 
 #include "actions/CChanges.h"
 
+#include "utilities/CAsyncWriter.h"
 #include "utilities/CSimConfig.h"
+#include "utilities/CDirEntry.h"
 #include "network/CNetwork.h"
+#include "diseaseModel/CModel.h"
+#include "utilities/CStreamBuffer.h"
 
 // static
 void CChanges::init()
 {
+  BinaryOutput = CSimConfig::getOutputWriter().format == "binary";
+
   Context.init();
   Context.Master().pDefaultOutput = new std::stringstream;
+  Context.Master().pBinaryOutput = new CTransitionBlock;
 
   Changes * pIt = Context.beginThread();
   Changes * pEnd = Context.endThread();
 
   for (; pIt != pEnd; ++pIt)
     if (Context.isThread(pIt))
-      pIt->pDefaultOutput = new std::stringstream;
+      {
+        pIt->pDefaultOutput = new std::stringstream;
+        pIt->pBinaryOutput = new CTransitionBlock;
+      }
 }
 
 // static
@@ -56,13 +68,17 @@ void CChanges::release()
   if (Context.size())
     {
       delete Context.Master().pDefaultOutput;
+      delete Context.Master().pBinaryOutput;
 
       Changes * pIt = Context.beginThread();
       Changes * pEnd = Context.endThread();
 
       for (; pIt != pEnd; ++pIt)
         if (Context.isThread(pIt))
-          delete pIt->pDefaultOutput;
+          {
+            delete pIt->pDefaultOutput;
+            delete pIt->pBinaryOutput;
+          }
     }
 
    Context.release();
@@ -83,78 +99,213 @@ void CChanges::incrementTick()
 // static
 void CChanges::reset()
 {
-#pragma omp parallel
-  {
-    CNode * it = CNetwork::Context.Active().beginNode();
-    CNode * end = CNetwork::Context.Active().endNode();
+  resetChangedNodes(Context.Master());
 
-    for (; it != end; ++it)
-      it->changed = false;
-  }
+  Changes * pIt = Context.beginThread();
+  Changes * pEnd = Context.endThread();
+
+  for (; pIt != pEnd; ++pIt)
+    if (Context.isThread(pIt))
+      resetChangedNodes(*pIt);
+
+  std::vector< std::vector< sChangedNode > >::iterator itRank = RankToChangedNodes.begin();
+  std::vector< std::vector< sChangedNode > >::iterator endRank = RankToChangedNodes.end();
+
+  for (; itRank != endRank; ++itRank)
+    itRank->clear();
+}
+
+// static
+void CChanges::resetChangedNodes(Changes & changes)
+{
+  std::vector< const CNode * >::const_iterator it = changes.ChangedNodes.begin();
+  std::vector< const CNode * >::const_iterator end = changes.ChangedNodes.end();
+
+  for (; it != end; ++it)
+    {
+      (*it)->changed = false;
+      (*it)->changedFields = 0;
+    }
+
+  changes.ChangedNodes.clear();
+}
+
+// static
+void CChanges::collectChangedNodes()
+{
+  std::vector< const CNode * > ChangedNodes = Context.Master().ChangedNodes;
+
+  Changes * pIt = Context.beginThread();
+  Changes * pEnd = Context.endThread();
+
+  for (; pIt != pEnd; ++pIt)
+    if (Context.isThread(pIt))
+      ChangedNodes.insert(ChangedNodes.end(), pIt->ChangedNodes.begin(), pIt->ChangedNodes.end());
+
+  // Sorting assures that the indexes for each rank are increasing.
+  std::sort(ChangedNodes.begin(), ChangedNodes.end());
+
+  RankToChangedNodes.resize(CCommunicate::MPIProcesses);
+
+  CNode * pFirst = CNetwork::Context.Master().beginNode();
+  CNode * pBeyond = CNetwork::Context.Master().endNode();
+
+  std::vector< const CNode * >::const_iterator it = ChangedNodes.begin();
+  std::vector< const CNode * >::const_iterator end = ChangedNodes.end();
+
+  for (; it != end; ++it)
+    {
+      // Only local nodes are requested by other ranks
+      if (*it < pFirst || pBeyond <= *it)
+        continue;
+
+      size_t Offset = *it - pFirst;
+      std::vector< sRequest >::const_iterator itRequest = Requests.begin() + RequestOffsets[Offset];
+      std::vector< sRequest >::const_iterator endRequest = Requests.begin() + RequestOffsets[Offset + 1];
+
+      for (; itRequest != endRequest; ++itRequest)
+        RankToChangedNodes[itRequest->rank].push_back({*it, itRequest->index});
+    }
+}
+
+// static
+std::string CChanges::getDefaultOutput()
+{
+  if (CSimConfig::getOutputWriter().mode != "perRank")
+    return CSimConfig::getOutput();
+
+  std::ostringstream File;
+  File << CSimConfig::getOutput() << "." << CCommunicate::MPIRank;
+
+  return File.str();
 }
 
 // static
 void CChanges::initDefaultOutput()
 {
-  if (CCommunicate::MPIRank == 0)
+  bool PerRank = CSimConfig::getOutputWriter().mode == "perRank";
+
+  if (CCommunicate::MPIRank == 0
+      || PerRank)
     {
       std::ofstream out;
 
-      out.open(CSimConfig::getOutput().c_str());
+      out.open(getDefaultOutput().c_str(), std::ios_base::binary);
 
       if (out.good())
         {
-          out << "tick,pid,exit_state,contact_pid";
-
-          if (CEdge::HasLocationId)
-            out << ",location_id";
-
-          out << std::endl;
+          if (BinaryOutput)
+            {
+              std::vector< std::string > States;
+              std::vector< CHealthState >::const_iterator it = CModel::GetStates().begin();
+              std::vector< CHealthState >::const_iterator end = CModel::GetStates().end();
+
+              for (; it != end; ++it)
+                States.push_back(it->getAnnId());
+
+              if (!CTransitionBlock::writeHeader(out, States, CEdge::HasLocationId))
+                {
+                  CLogger::error("CChanges::initDefaultOutput: Failed to write header to '{}'.", getDefaultOutput());
+                  exit(EXIT_FAILURE);
+                }
+            }
+          else
+            CTransitionBlock::writeCSVHeader(out, CEdge::HasLocationId);
         }
       else
         {
-          CLogger::error("Error (Rank 0): Failed to open file '" + CSimConfig::getOutput() + "'.");
+          CLogger::error("CChanges::initDefaultOutput: Failed to open file '{}'.", getDefaultOutput());
           exit(EXIT_FAILURE);
         }
 
       out.close();
     }
+
+  // The manifest lists the files of all ranks, each of which starts with the header.
+  if (PerRank
+      && CCommunicate::MPIRank == 0)
+    {
+      json_t * pRoot = json_object();
+      json_t * pParts = json_array();
+
+      for (int i = 0; i < CCommunicate::MPIProcesses; ++i)
+        {
+          std::ostringstream File;
+          File << CDirEntry::fileName(CSimConfig::getOutput()) << "." << i;
+          json_array_append_new(pParts, json_string(File.str().c_str()));
+        }
+
+      json_object_set_new(pRoot, "numberOfParts", json_integer(CCommunicate::MPIProcesses));
+      json_object_set_new(pRoot, "parts", pParts);
+
+      std::ofstream out((CSimConfig::getOutput() + ".manifest").c_str());
+      out << CSimConfig::jsonToString(pRoot) << std::endl;
+
+      if (out.fail())
+        {
+          CLogger::error("CChanges::initDefaultOutput: Failed to write file '{}'.", CSimConfig::getOutput() + ".manifest");
+          exit(EXIT_FAILURE);
+        }
+
+      json_decref(pRoot);
+    }
 }
 
 // static
 bool CChanges::writeDefaultOutput()
 {
+  const std::string & Mode = CSimConfig::getOutputWriter().mode;
+
+  // Without coordination between ranks the data are handed off to the background writer.
+  if (CAsyncWriter::isRunning()
+      && (Mode == "perRank" || CCommunicate::MPIProcesses == 1))
+    {
+      std::ostringstream Data;
+      writeDefaultOutput(Data);
+
+      return CAsyncWriter::append(getDefaultOutput(), Data.str());
+    }
+
+  if (Mode == "perRank")
+    return writeDefaultOutputData() == CCommunicate::ErrorCode::Success;
+
+  if (Mode == "collective")
+    {
+      std::ostringstream Data;
+      writeDefaultOutput(Data);
+
+      if (CCommunicate::appendAll(CSimConfig::getOutput(), Data.str()) != (int) CCommunicate::ErrorCode::Success)
+        {
+          CLogger::error("CChanges::writeDefaultOutput: Failed to write '{}'.", CSimConfig::getOutput());
+          return false;
+        }
+
+      return true;
+    }
+
   CCommunicate::SequentialProcess WriteData(&CChanges::writeDefaultOutputData);
   return CCommunicate::sequential(0, &WriteData) == (int) CCommunicate::ErrorCode::Success;
 }
 
-// static
 CCommunicate::ErrorCode CChanges::writeDefaultOutputData()
 {
   std::ofstream out;
 
-  out.open(CSimConfig::getOutput().c_str(), std::ios_base::app);
+  out.open(getDefaultOutput().c_str(), std::ios_base::app | std::ios_base::binary);
 
   if (out.fail())
     {
-      CLogger::error("CChanges::writeDefaultOutputData: Failed to open '{}'.", CSimConfig::getOutput());
+      CLogger::error("CChanges::writeDefaultOutputData: Failed to open '{}'.", getDefaultOutput());
       return CCommunicate::ErrorCode::FileOpenError;
     }
   else
     {
-      Changes * pIt = Context.beginThread();
-      Changes * pEnd = Context.endThread();
-
-      for (; pIt != pEnd && out.good(); ++pIt)
-        {
-          out << pIt->pDefaultOutput->str();
-          pIt->pDefaultOutput->str("");
-        }
+      writeDefaultOutput(out);
     }
 
   if (out.fail())
     {
-      CLogger::error("CChanges::writeDefaultOutputData: Failed to write '{}'.", CSimConfig::getOutput());
+      CLogger::error("CChanges::writeDefaultOutputData: Failed to write '{}'.", getDefaultOutput());
       return CCommunicate::ErrorCode::FileWriteError;
     }
 
@@ -162,19 +313,38 @@ CCommunicate::ErrorCode CChanges::writeDefaultOutputData()
 
   if (out.fail())
     {
-      CLogger::error("CChanges::writeDefaultOutputData: Failed to close '{}'.", CSimConfig::getOutput());
+      CLogger::error("CChanges::writeDefaultOutputData: Failed to close '{}'.", getDefaultOutput());
       return CCommunicate::ErrorCode::FileCloseError;
     }
 
   return CCommunicate::ErrorCode::Success;
 }
 
+// static
+void CChanges::writeDefaultOutput(std::ostream & os)
+{
+  Changes * pIt = Context.beginThread();
+  Changes * pEnd = Context.endThread();
+
+  for (; pIt != pEnd && os.good(); ++pIt)
+    if (BinaryOutput)
+      {
+        pIt->pBinaryOutput->write(os, CEdge::HasLocationId);
+        pIt->pBinaryOutput->clear();
+      }
+    else
+      {
+        os << pIt->pDefaultOutput->str();
+        pIt->pDefaultOutput->str("");
+      }
+}
+
 // static
 CCommunicate::ErrorCode CChanges::determineNodesRequested()
 {
-  const std::map< size_t, CNode * > & RemoteNodes = CNetwork::Context.Master().getRemoteNodes();
-  std::map< size_t, CNode * >::const_iterator it = RemoteNodes.begin();
-  std::map< size_t, CNode * >::const_iterator end = RemoteNodes.end();
+  const std::vector< std::pair< size_t, CNode * > > & RemoteNodes = CNetwork::Context.Master().getRemoteNodes();
+  std::vector< std::pair< size_t, CNode * > >::const_iterator it = RemoteNodes.begin();
+  std::vector< std::pair< size_t, CNode * > >::const_iterator end = RemoteNodes.end();
 
   size_t * pBuffer = RemoteNodes.size() > 0 ? new size_t[RemoteNodes.size()] : NULL;
   size_t * pId = pBuffer;
@@ -191,53 +361,182 @@ CCommunicate::ErrorCode CChanges::determineNodesRequested()
   if (pBuffer != NULL)
     delete[] pBuffer;
 
+  // Record for each local node which ranks requested it and at which index.
+  CNetwork & Master = CNetwork::Context.Master();
+  CNode * pFirst = Master.beginNode();
+
+  RequestOffsets.assign(Master.getLocalNodeCount() + 1, 0);
+
+  std::map< size_t, std::set< const CNode * > >::const_iterator itRank = RankToNodesRequested.begin();
+  std::map< size_t, std::set< const CNode * > >::const_iterator endRank = RankToNodesRequested.end();
+
+  for (; itRank != endRank; ++itRank)
+    for (const CNode * pNode : itRank->second)
+      ++RequestOffsets[pNode - pFirst + 1];
+
+  for (size_t i = 1; i < RequestOffsets.size(); ++i)
+    RequestOffsets[i] += RequestOffsets[i - 1];
+
+  Requests.resize(RequestOffsets.back());
+  std::vector< size_t > Next(RequestOffsets.begin(), RequestOffsets.end() - 1);
+
+  for (itRank = RankToNodesRequested.begin(); itRank != endRank; ++itRank)
+    {
+      size_t Index = 0;
+
+      for (const CNode * pNode : itRank->second)
+        Requests[Next[pNode - pFirst]++] = {(int) itRank->first, Index++};
+    }
+
+  // Each rank replies with the ids of the requested nodes it owns in the order used when
+  // sending changes, which allows the receiver to identify nodes by their index.
+  RankToRemoteNodes.assign(CCommunicate::MPIProcesses, std::vector< CNode * >());
+
+  CCommunicate::Send SendProvided(&CChanges::sendNodesProvided);
+  CCommunicate::Receive ReceiveProvided(&CChanges::receiveNodesProvided);
+  CCommunicate::roundRobin(&SendProvided, &ReceiveProvided);
+
+  // Determine the neighboring ranks, i.e., the ranks we need to send changes to and the ranks
+  // we will receive changes from.
+  RanksToSend.clear();
+  RanksToReceive.clear();
+
+  for (int rank = 0; rank < CCommunicate::MPIProcesses; ++rank)
+    {
+      if (rank == CCommunicate::MPIRank)
+        continue;
+
+      std::map< size_t, std::set< const CNode * > >::const_iterator found = RankToNodesRequested.find(rank);
+
+      if (found != RankToNodesRequested.end() && !found->second.empty())
+        RanksToSend.push_back(rank);
+
+      if (!RankToRemoteNodes[rank].empty())
+        RanksToReceive.push_back(rank);
+    }
+
+  CLogger::debug("CChanges::determineNodesRequested: sending to {} and receiving from {} ranks.", RanksToSend.size(), RanksToReceive.size());
+
+  return CCommunicate::ErrorCode::Success;
+}
+
+// static
+CCommunicate::ErrorCode CChanges::sendNodesProvided(std::ostream & os, int receiver)
+{
+  std::map< size_t, std::set< const CNode * > >::const_iterator found = RankToNodesRequested.find(receiver);
+
+  if (found == RankToNodesRequested.end())
+    return CCommunicate::ErrorCode::Success;
+
+  std::set< const CNode * >::const_iterator it = found->second.begin();
+  std::set< const CNode * >::const_iterator end = found->second.end();
+
+  for (; it != end; ++it)
+    os.write(reinterpret_cast< const char * >(&(*it)->id), sizeof(size_t));
+
   return CCommunicate::ErrorCode::Success;
 }
 
+// static
+CCommunicate::ErrorCode CChanges::receiveNodesProvided(std::istream & is, int sender)
+{
+  std::vector< CNode * > & RemoteNodes = RankToRemoteNodes[sender];
+  RemoteNodes.clear();
+
+  CNetwork & Master = CNetwork::Context.Master();
+  size_t id;
+
+  while (true)
+    {
+      is.read(reinterpret_cast< char * >(&id), sizeof(size_t));
+
+      if (is.fail())
+        break;
+
+      // The index must be preserved even if the node is unknown.
+      RemoteNodes.push_back(Master.lookupNode(id, false));
+    }
+
+  return CCommunicate::ErrorCode::Success;
+}
+
+// static
+const std::vector< CNode * > & CChanges::getRemoteNodes(int rank)
+{
+  return RankToRemoteNodes[rank];
+}
+
+// static
+const std::vector< int > & CChanges::getRanksToSend()
+{
+  return RanksToSend;
+}
+
+// static
+const std::vector< int > & CChanges::getRanksToReceive()
+{
+  return RanksToReceive;
+}
+
 // static
 CCommunicate::ErrorCode CChanges::sendNodesRequested(std::ostream & os, int receiver)
 {
   size_t Count = 0;
+  bool Compact = CSimConfig::getNodeExchange().encoding == "compact";
+  const std::vector< sChangedNode > & ChangedNodes = RankToChangedNodes[receiver];
 
 #pragma omp parallel shared(os) reduction(+: Count)
   {
-    CNode * it = CNetwork::Context.Active().beginNode();
-    CNode * end = CNetwork::Context.Active().endNode();
-
-    std::ostringstream OutStream;
+    // Each thread encodes its own slice of the changed nodes.
+    size_t Slice = (ChangedNodes.size() + omp_get_num_threads() - 1) / omp_get_num_threads();
+    size_t First = std::min(ChangedNodes.size(), omp_get_thread_num() * Slice);
+    size_t Beyond = std::min(ChangedNodes.size(), First + Slice);
 
-    // std::set< const CNode * >::const_iterator it = Active.__Nodes.begin();
-    // std::set< const CNode * >::const_iterator end = Active.__Nodes.end();
+    std::vector< sChangedNode >::const_iterator it = ChangedNodes.begin() + First;
+    std::vector< sChangedNode >::const_iterator end = ChangedNodes.begin() + Beyond;
 
-    const std::set< const CNode * > & Requested = RankToNodesRequested[receiver];
-    std::set< const CNode * >::const_iterator itRequested = Requested.begin();
-    std::set< const CNode * >::const_iterator endRequested = Requested.end();
+    std::ostringstream OutStream;
+    size_t ThreadCount = 0;
+    size_t PreviousIndex = 0;
 
-    while (it != end && itRequested != endRequested)
-      if (it < *itRequested)
-        {
-          ++it;
-        }
-      else if (it > *itRequested)
-        {
-          ++itRequested;
-        }
-      else
+    // Nodes are identified by their index in the requested nodes.
+    for (; it != end; ++it)
+      if (Compact)
         {
-          if (it->changed)
+          if (it->pNode->changedFields != 0)
             {
-              ENABLE_TRACE(CLogger::trace("CChanges: send node '{}'.", it->id););
+              ENABLE_TRACE(CLogger::trace("CChanges: send node '{}'.", it->pNode->id););
 
-              it->toBinary(OutStream);
-              ++Count;
+              CStreamBuffer::writeVarint(OutStream, it->index - PreviousIndex);
+              it->pNode->toCompactBinary(OutStream);
+              PreviousIndex = it->index;
+              ++ThreadCount;
             }
+        }
+      else
+        {
+          ENABLE_TRACE(CLogger::trace("CChanges: send node '{}'.", it->pNode->id););
 
-          ++it;
-          ++itRequested;
+          OutStream.write(reinterpret_cast< const char * >(&it->index), sizeof(size_t));
+          it->pNode->toBinary(OutStream);
+          ++ThreadCount;
         }
 
+    Count += ThreadCount;
+
+    // The compact encoding of each thread is preceded by its node count and size in bytes
+    // as the indexes are delta encoded within each thread's sorted nodes.
+    if (ThreadCount > 0)
 #pragma omp critical (send_changes)
-    os << OutStream.str();
+      {
+        if (Compact)
+          {
+            CStreamBuffer::writeVarint(os, ThreadCount);
+            CStreamBuffer::writeVarint(os, OutStream.tellp());
+          }
+
+        os << OutStream.str();
+      }
   }
 
   CLogger::debug("CChanges: Sending '{}' nodes to: '{}'.", Count, receiver);
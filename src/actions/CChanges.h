@@ -33,11 +33,15 @@
 #define SRC_ACTIONS_CHANGES_H_
 
 #include <sstream>
+#include <limits>
 #include <set>
 #include <map>
+#include <vector>
 
+#include "actions/CTransitionBlock.h"
 #include "utilities/CCommunicate.h"
 #include "utilities/CContext.h"
+#include "network/CNetwork.h"
 #include "network/CNode.h"
 #include "network/CEdge.h"
 #include "diseaseModel/CHealthState.h"
@@ -52,12 +56,53 @@ public:
   template < class Entity >
   static  void record(const Entity * pEntity, const CMetadata & metadata);
 
+  /**
+   * Mark the node as changed and append it to the changed nodes of the active thread
+   * @param const CNode * pNode
+   */
+  static void markChanged(const CNode * pNode);
+
+  /**
+   * Distribute the changed nodes of all threads to the ranks which requested them. This must
+   * be called prior to sending the requested nodes.
+   */
+  static void collectChangedNodes();
+
+  /**
+   * Retrieve the file this rank writes the default output to, which is the configured output
+   * unless the output writer mode is perRank.
+   * @return std::string file
+   */
+  static std::string getDefaultOutput();
+
   static void initDefaultOutput();
   static bool writeDefaultOutput();
   static CCommunicate::ErrorCode writeDefaultOutputData();
   static CCommunicate::ErrorCode sendNodesRequested(std::ostream & os, int sender);
   static CCommunicate::ErrorCode determineNodesRequested();
   static CCommunicate::ErrorCode receiveNodesRequested(std::istream & is, int sender);
+  static CCommunicate::ErrorCode sendNodesProvided(std::ostream & os, int receiver);
+  static CCommunicate::ErrorCode receiveNodesProvided(std::istream & is, int sender);
+
+  /**
+   * Retrieve the remote nodes owned by the given rank in the order in which the rank
+   * identifies them when sending changes. Unknown nodes are NULL.
+   * @param int rank
+   * @return const std::vector< CNode * > & remoteNodes
+   */
+  static const std::vector< CNode * > & getRemoteNodes(int rank);
+
+  /**
+   * Retrieve the ranks which requested at least one local node
+   * @return const std::vector< int > & ranksToSend
+   */
+  static const std::vector< int > & getRanksToSend();
+
+  /**
+   * Retrieve the ranks which own at least one of the requested remote nodes
+   * @return const std::vector< int > & ranksToReceive
+   */
+  static const std::vector< int > & getRanksToReceive();
   static void setCurrentTick(size_t tick);
   static void incrementTick();
   static void reset();
@@ -66,13 +111,55 @@ private:
   struct Changes
   {
     std::stringstream *pDefaultOutput;
+    CTransitionBlock *pBinaryOutput;
+    std::vector< const CNode * > ChangedNodes;
   };
 
+  struct sRequest
+  {
+    int rank;
+    size_t index;
+  };
+
+  struct sChangedNode
+  {
+    const CNode * pNode;
+    size_t index;
+  };
+
+  static void resetChangedNodes(Changes & changes);
+
+  /**
+   * Write and clear the default output of all threads
+   * @param std::ostream & os
+   */
+  static void writeDefaultOutput(std::ostream & os);
+
   static CContext< Changes > Context;
   static std::map< size_t, std::set< const CNode * > > RankToNodesRequested;
+
+  // The ranks requesting each local node and the node's index in their requests, stored
+  // consecutively for each node starting at RequestOffsets[local node].
+  static std::vector< size_t > RequestOffsets;
+  static std::vector< sRequest > Requests;
+  static std::vector< std::vector< sChangedNode > > RankToChangedNodes;
+  static std::vector< std::vector< CNode * > > RankToRemoteNodes;
+  static std::vector< int > RanksToSend;
+  static std::vector< int > RanksToReceive;
   static size_t Tick;
+  static bool BinaryOutput;
 };
 
+// static
+inline void CChanges::markChanged(const CNode * pNode)
+{
+  if (pNode->changed)
+    return;
+
+  pNode->changed = true;
+  Context.Active().ChangedNodes.push_back(pNode);
+}
+
 template <>
 // static 
 inline void CChanges::record(const CNode * pNode, const CMetadata & metadata)
@@ -80,13 +167,24 @@ inline void CChanges::record(const CNode * pNode, const CMetadata & metadata)
     if (pNode == NULL)
       return;
 
-    pNode->changed = true;
+    markChanged(pNode);
     Changes & Active = Context.Active();
 
     if (metadata.getBool("StateChange"))
       {
+        if (BinaryOutput)
+          {
+            static const size_t Missing = std::numeric_limits< size_t >::max();
+
+            Active.pBinaryOutput->append((int) Tick, CNetwork::OriginalPid(pNode), pNode->getHealthState()->getIndex(),
+                                         metadata.contains("ContactNode") ? (size_t) metadata.getInt("ContactNode") : Missing,
+                                         CEdge::HasLocationId && metadata.contains("LocationId") ? (size_t) metadata.getInt("LocationId") : Missing);
+
+            return;
+          }
+
         // "tick,pid,exit_state,contact_pid,[locationId]"
-        (*Active.pDefaultOutput) << (int) Tick << "," << pNode->id << "," << pNode->getHealthState()->getAnnId() << ",";
+        (*Active.pDefaultOutput) << (int) Tick << "," << CNetwork::OriginalPid(pNode) << "," << pNode->getHealthState()->getAnnId() << ",";
 
         if (metadata.contains("ContactNode"))
           {
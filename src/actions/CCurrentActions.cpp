@@ -128,6 +128,11 @@ CCurrentActions::CCurrentActions()
 
 // virtual
 CCurrentActions::~CCurrentActions()
+{
+  reset();
+}
+
+void CCurrentActions::reset()
 {
   base::iterator itMap = base::begin();
   base::iterator endMap = base::end();
@@ -180,3 +185,45 @@ void CCurrentActions::clear()
     itMap->clear();
 }
 
+
+void CCurrentActions::toBinary(std::ostream & os) const
+{
+  size_t Size = size();
+  os.write(reinterpret_cast< const char * >(&Size), sizeof(size_t));
+
+  base::const_iterator itMap = base::begin();
+  base::const_iterator endMap = base::end();
+
+  for (; itMap != endMap; ++itMap)
+    {
+      std::vector< CAction * >::const_iterator it = itMap->begin();
+      std::vector< CAction * >::const_iterator end = itMap->end();
+
+      for (; it != end; ++it)
+        (*it)->toBinary(os);
+    }
+}
+
+bool CCurrentActions::fromBinary(std::istream & is)
+{
+  size_t Size;
+  is.read(reinterpret_cast< char * >(&Size), sizeof(size_t));
+
+  if (is.fail())
+    return false;
+
+  for (size_t i = 0; i < Size; ++i)
+    {
+      CAction * pAction = CAction::fromBinary(is);
+
+      if (pAction == NULL)
+        {
+          CLogger::error("CCurrentActions: Failed to restore action ({} of {}).", i, Size);
+          return false;
+        }
+
+      addAction(pAction);
+    }
+
+  return true;
+}
@@ -78,6 +78,15 @@ public:
 
   void clear();
 
+  /**
+   * Destroy all actions while keeping the allocated storage
+   */
+  void reset();
+
+  void toBinary(std::ostream & os) const;
+
+  bool fromBinary(std::istream & is);
+
 private:
 };
 
@@ -24,6 +24,9 @@
 
 #include "actions/CEdgeAction.h"
 #include "actions/CActionDefinition.h"
+#include "network/CNetwork.h"
+#include "network/CEdge.h"
+#include "network/CNode.h"
 
 CEdgeAction::CEdgeAction(const CActionDefinition * pDefinition, const CEdge * pTarget)
   : CAction()
@@ -46,3 +49,39 @@ bool CEdgeAction::execute() const
 {
   return mpDefinition->execute(const_cast< CEdge * >(mpTarget));
 }
+
+void CEdgeAction::toBinary(std::ostream & os) const
+{
+  // Edges are identified by their target and their position within the edges of the target.
+  size_t Offset = mpTarget - mpTarget->target()->Edges;
+
+  os << 'E';
+  os.write(reinterpret_cast< const char * >(&mpDefinition->getIndex()), sizeof(size_t));
+  os.write(reinterpret_cast< const char * >(&mpTarget->targetId), sizeof(size_t));
+  os.write(reinterpret_cast< const char * >(&Offset), sizeof(size_t));
+}
+
+// static
+CAction * CEdgeAction::fromBinary(std::istream & is)
+{
+  size_t Index;
+  size_t TargetId;
+  size_t Offset;
+
+  is.read(reinterpret_cast< char * >(&Index), sizeof(size_t));
+  is.read(reinterpret_cast< char * >(&TargetId), sizeof(size_t));
+  is.read(reinterpret_cast< char * >(&Offset), sizeof(size_t));
+
+  if (is.fail())
+    return NULL;
+
+  const CActionDefinition * pDefinition = CActionDefinition::GetActionDefinition(Index);
+  const CNode * pTarget = CNetwork::Context.Master().lookupNode(TargetId, true);
+
+  if (pDefinition == NULL
+      || pTarget == NULL
+      || Offset >= pTarget->EdgesSize)
+    return NULL;
+
+  return new CEdgeAction(pDefinition, pTarget->Edges + Offset);
+}
@@ -45,6 +45,10 @@ public:
   
   virtual bool execute() const override;
 
+  virtual void toBinary(std::ostream & os) const override;
+
+  static CAction * fromBinary(std::istream & is);
+
 private:
   const CActionDefinition * mpDefinition;
   const CEdge * mpTarget;  
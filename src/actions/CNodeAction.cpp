@@ -24,6 +24,8 @@
 
 #include "actions/CNodeAction.h"
 #include "actions/CActionDefinition.h"
+#include "network/CNetwork.h"
+#include "network/CNode.h"
 
 CNodeAction::CNodeAction(const CActionDefinition * pDefinition, const CNode * pTarget)
   : CAction()
@@ -46,3 +48,32 @@ bool CNodeAction::execute() const
 {
   return mpDefinition->execute(const_cast< CNode * >(mpTarget));
 }
+
+void CNodeAction::toBinary(std::ostream & os) const
+{
+  os << 'N';
+  os.write(reinterpret_cast< const char * >(&mpDefinition->getIndex()), sizeof(size_t));
+  os.write(reinterpret_cast< const char * >(&mpTarget->id), sizeof(size_t));
+}
+
+// static
+CAction * CNodeAction::fromBinary(std::istream & is)
+{
+  size_t Index;
+  size_t NodeId;
+
+  is.read(reinterpret_cast< char * >(&Index), sizeof(size_t));
+  is.read(reinterpret_cast< char * >(&NodeId), sizeof(size_t));
+
+  if (is.fail())
+    return NULL;
+
+  const CActionDefinition * pDefinition = CActionDefinition::GetActionDefinition(Index);
+  const CNode * pTarget = CNetwork::Context.Master().lookupNode(NodeId, false);
+
+  if (pDefinition == NULL
+      || pTarget == NULL)
+    return NULL;
+
+  return new CNodeAction(pDefinition, pTarget);
+}
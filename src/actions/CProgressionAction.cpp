@@ -26,6 +26,8 @@
 #include "actions/COperation.h"
 #include "diseaseModel/CProgression.h"
 #include "diseaseModel/CHealthState.h"
+#include "diseaseModel/CModel.h"
+#include "network/CNetwork.h"
 #include "network/CNode.h"
 #include "utilities/CMetadata.h"
 #include "utilities/CLogger.h"
@@ -73,3 +75,43 @@ bool CProgressionAction::execute() const
 
   return success;
 }
+
+void CProgressionAction::toBinary(std::ostream & os) const
+{
+  size_t Index = mpProgression - CModel::GetProgressions().data();
+
+  os << 'P';
+  os.write(reinterpret_cast< const char * >(&Index), sizeof(size_t));
+  os.write(reinterpret_cast< const char * >(&mpTarget->id), sizeof(size_t));
+  mStateAtScheduleTime.toBinary(os);
+}
+
+// static
+CAction * CProgressionAction::fromBinary(std::istream & is)
+{
+  size_t Index;
+  size_t NodeId;
+
+  is.read(reinterpret_cast< char * >(&Index), sizeof(size_t));
+  is.read(reinterpret_cast< char * >(&NodeId), sizeof(size_t));
+
+  if (is.fail()
+      || Index >= CModel::GetProgressions().size())
+    return NULL;
+
+  CNode * pTarget = CNetwork::Context.Master().lookupNode(NodeId, true);
+
+  if (pTarget == NULL)
+    return NULL;
+
+  CProgressionAction * pAction = new CProgressionAction(CModel::GetProgressions().data() + Index, pTarget);
+  pAction->mStateAtScheduleTime.fromBinary(is);
+
+  if (is.fail())
+    {
+      delete pAction;
+      return NULL;
+    }
+
+  return pAction;
+}
@@ -0,0 +1,307 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include <cstring>
+#include <limits>
+
+#include "actions/CTransitionBlock.h"
+#include "utilities/CStreamBuffer.h"
+#include "EpiHiperConfig.h"
+
+#ifdef USE_ZLIB
+# include <zlib.h>
+#endif // USE_ZLIB
+
+// static
+const char CTransitionBlock::Magic[8] = "EHTRANS";
+
+// static
+const uint32_t CTransitionBlock::Version = 1;
+
+// static
+bool CTransitionBlock::writeHeader(std::ostream & os, const std::vector< std::string > & states, bool hasLocationId)
+{
+  // The exit state is stored as uint16
+  if (states.size() > std::numeric_limits< uint16_t >::max())
+    return false;
+
+  os.write(Magic, sizeof(Magic));
+  os.write(reinterpret_cast< const char * >(&Version), sizeof(uint32_t));
+  os.put(hasLocationId ? 1 : 0);
+
+  CStreamBuffer::writeVarint(os, states.size());
+
+  std::vector< std::string >::const_iterator it = states.begin();
+  std::vector< std::string >::const_iterator end = states.end();
+
+  for (; it != end; ++it)
+    {
+      CStreamBuffer::writeVarint(os, it->size());
+      os.write(it->c_str(), it->size());
+    }
+
+  return !os.fail();
+}
+
+// static
+bool CTransitionBlock::readHeader(std::istream & is, std::vector< std::string > & states, bool & hasLocationId)
+{
+  char Buffer[sizeof(Magic)];
+  uint32_t FileVersion;
+
+  is.read(Buffer, sizeof(Magic));
+  is.read(reinterpret_cast< char * >(&FileVersion), sizeof(uint32_t));
+
+  if (is.fail()
+      || memcmp(Buffer, Magic, sizeof(Magic)) != 0
+      || FileVersion != Version)
+    return false;
+
+  hasLocationId = is.get() != 0;
+
+  size_t Size;
+
+  if (!CStreamBuffer::readVarint(is, Size))
+    return false;
+
+  states.resize(Size);
+
+  std::vector< std::string >::iterator it = states.begin();
+  std::vector< std::string >::iterator end = states.end();
+
+  for (; it != end && !is.fail(); ++it)
+    {
+      if (!CStreamBuffer::readVarint(is, Size))
+        return false;
+
+      it->resize(Size);
+      is.read(&(*it)[0], Size);
+    }
+
+  return !is.fail();
+}
+
+// static
+void CTransitionBlock::writeCSVHeader(std::ostream & os, bool hasLocationId)
+{
+  os << "tick,pid,exit_state,contact_pid";
+
+  if (hasLocationId)
+    os << ",location_id";
+
+  os << std::endl;
+}
+
+CTransitionBlock::CTransitionBlock()
+  : mTicks()
+  , mPids()
+  , mStates()
+  , mContacts()
+  , mLocations()
+{}
+
+// virtual
+CTransitionBlock::~CTransitionBlock()
+{}
+
+void CTransitionBlock::append(int tick, size_t pid, size_t state, size_t contact, size_t location)
+{
+  mTicks.push_back(tick);
+  mPids.push_back(pid);
+  mStates.push_back(state);
+  mContacts.push_back(contact);
+  mLocations.push_back(location);
+}
+
+size_t CTransitionBlock::size() const
+{
+  return mPids.size();
+}
+
+void CTransitionBlock::clear()
+{
+  mTicks.clear();
+  mPids.clear();
+  mStates.clear();
+  mContacts.clear();
+  mLocations.clear();
+}
+
+// static
+template < class Type >
+void CTransitionBlock::appendColumn(std::string & data, const std::vector< Type > & column)
+{
+  data.append(reinterpret_cast< const char * >(column.data()), column.size() * sizeof(Type));
+}
+
+// static
+template < class Type >
+const char * CTransitionBlock::readColumn(const char * pData, std::vector< Type > & column, size_t size)
+{
+  column.resize(size);
+  memcpy(column.data(), pData, size * sizeof(Type));
+
+  return pData + size * sizeof(Type);
+}
+
+void CTransitionBlock::write(std::ostream & os, bool hasLocationId) const
+{
+  uint64_t Count = size();
+
+  if (Count == 0)
+    return;
+
+  std::string Raw;
+
+  appendColumn(Raw, mTicks);
+  appendColumn(Raw, mPids);
+  appendColumn(Raw, mStates);
+  appendColumn(Raw, mContacts);
+
+  if (hasLocationId)
+    appendColumn(Raw, mLocations);
+
+  Compression Method = Compression::None;
+  const std::string * pStored = &Raw;
+
+#ifdef USE_ZLIB
+  std::string Compressed;
+  uLongf CompressedSize = compressBound(Raw.size());
+  Compressed.resize(CompressedSize);
+
+  // We favor speed as the output is written within the tick loop.
+  if (compress2(reinterpret_cast< Bytef * >(&Compressed[0]), &CompressedSize,
+                reinterpret_cast< const Bytef * >(Raw.data()), Raw.size(), Z_BEST_SPEED) == Z_OK
+      && CompressedSize < Raw.size())
+    {
+      Compressed.resize(CompressedSize);
+      Method = Compression::Zlib;
+      pStored = &Compressed;
+    }
+#endif // USE_ZLIB
+
+  uint64_t RawSize = Raw.size();
+  uint64_t StoredSize = pStored->size();
+
+  os.write(reinterpret_cast< const char * >(&Count), sizeof(uint64_t));
+  os.put((char) Method);
+  os.write(reinterpret_cast< const char * >(&RawSize), sizeof(uint64_t));
+  os.write(reinterpret_cast< const char * >(&StoredSize), sizeof(uint64_t));
+  os.write(pStored->data(), StoredSize);
+}
+
+bool CTransitionBlock::read(std::istream & is, bool hasLocationId)
+{
+  clear();
+
+  uint64_t Count;
+  char Method;
+  uint64_t RawSize;
+  uint64_t StoredSize;
+
+  is.read(reinterpret_cast< char * >(&Count), sizeof(uint64_t));
+  is.get(Method);
+  is.read(reinterpret_cast< char * >(&RawSize), sizeof(uint64_t));
+  is.read(reinterpret_cast< char * >(&StoredSize), sizeof(uint64_t));
+
+  if (is.fail()
+      || RawSize != Count * (sizeof(int32_t) + sizeof(uint16_t) + 2 * sizeof(uint64_t) + (hasLocationId ? sizeof(uint64_t) : 0)))
+    return false;
+
+  std::string Stored;
+  Stored.resize(StoredSize);
+  is.read(&Stored[0], StoredSize);
+
+  if (is.fail())
+    return false;
+
+  std::string Raw;
+
+  switch ((Compression) Method)
+    {
+    case Compression::None:
+      if (StoredSize != RawSize)
+        return false;
+
+      Raw.swap(Stored);
+      break;
+
+    case Compression::Zlib:
+#ifdef USE_ZLIB
+      {
+        Raw.resize(RawSize);
+        uLongf Size = RawSize;
+
+        if (uncompress(reinterpret_cast< Bytef * >(&Raw[0]), &Size,
+                       reinterpret_cast< const Bytef * >(Stored.data()), StoredSize) != Z_OK
+            || Size != RawSize)
+          return false;
+      }
+      break;
+#else
+      // Compressed blocks require zlib.
+      return false;
+#endif // USE_ZLIB
+
+    default:
+      return false;
+    }
+
+  const char * pData = Raw.data();
+
+  pData = readColumn(pData, mTicks, Count);
+  pData = readColumn(pData, mPids, Count);
+  pData = readColumn(pData, mStates, Count);
+  pData = readColumn(pData, mContacts, Count);
+
+  if (hasLocationId)
+    readColumn(pData, mLocations, Count);
+
+  return true;
+}
+
+void CTransitionBlock::toCSV(std::ostream & os, const std::vector< std::string > & states, bool hasLocationId) const
+{
+  static const uint64_t Missing = std::numeric_limits< uint64_t >::max();
+
+  for (size_t i = 0, imax = size(); i < imax; ++i)
+    {
+      os << mTicks[i] << "," << mPids[i] << "," << states[mStates[i]] << ",";
+
+      if (mContacts[i] != Missing)
+        os << mContacts[i];
+      else
+        os << -1;
+
+      if (hasLocationId)
+        {
+          if (mLocations[i] != Missing)
+            os << "," << mLocations[i];
+          else
+            os << "," << -1;
+        }
+
+      os << "\n";
+    }
+}
@@ -0,0 +1,136 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_ACTIONS_CTRANSITIONBLOCK_H_
+#define SRC_ACTIONS_CTRANSITIONBLOCK_H_
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * A block of state transitions stored in columns for the binary default output.
+ *
+ * The binary output consists of a header followed by any number of blocks:
+ *   header  the magic "EHTRANS", the format version, whether location ids are present,
+ *           and the dictionary of health state ids
+ *   block   the record count, the compression, the raw and the stored size, and the
+ *           stored columns tick (int32), pid (uint64), exit_state (uint16 dictionary index),
+ *           contact_pid (uint64), and location_id (uint64, if present)
+ * Missing contact and location ids are stored as the maximal value and written as -1.
+ */
+class CTransitionBlock
+{
+public:
+  enum struct Compression : unsigned char
+  {
+    None = 0,
+    Zlib = 1
+  };
+
+  /**
+   * Write the header of the binary output
+   * @param std::ostream & os
+   * @param const std::vector< std::string > & states
+   * @param bool hasLocationId
+   * @return bool success
+   */
+  static bool writeHeader(std::ostream & os, const std::vector< std::string > & states, bool hasLocationId);
+
+  /**
+   * Read the header of the binary output
+   * @param std::istream & is
+   * @param std::vector< std::string > & states
+   * @param bool & hasLocationId
+   * @return bool success
+   */
+  static bool readHeader(std::istream & is, std::vector< std::string > & states, bool & hasLocationId);
+
+  /**
+   * Write the CSV header matching the binary output
+   * @param std::ostream & os
+   * @param bool hasLocationId
+   */
+  static void writeCSVHeader(std::ostream & os, bool hasLocationId);
+
+  CTransitionBlock();
+
+  virtual ~CTransitionBlock();
+
+  /**
+   * Append a transition record
+   * @param int tick
+   * @param size_t pid
+   * @param size_t state the index of the exit state in the dictionary
+   * @param size_t contact
+   * @param size_t location
+   */
+  void append(int tick, size_t pid, size_t state, size_t contact, size_t location);
+
+  size_t size() const;
+
+  void clear();
+
+  /**
+   * Write the block if it is not empty. The columns are compressed if zlib is available.
+   * @param std::ostream & os
+   * @param bool hasLocationId
+   */
+  void write(std::ostream & os, bool hasLocationId) const;
+
+  /**
+   * Read the next block replacing the current records
+   * @param std::istream & is
+   * @param bool hasLocationId
+   * @return bool success
+   */
+  bool read(std::istream & is, bool hasLocationId);
+
+  /**
+   * Write the records as CSV lines
+   * @param std::ostream & os
+   * @param const std::vector< std::string > & states
+   * @param bool hasLocationId
+   */
+  void toCSV(std::ostream & os, const std::vector< std::string > & states, bool hasLocationId) const;
+
+private:
+  static const char Magic[8];
+  static const uint32_t Version;
+
+  template < class Type >
+  static void appendColumn(std::string & data, const std::vector< Type > & column);
+
+  template < class Type >
+  static const char * readColumn(const char * pData, std::vector< Type > & column, size_t size);
+
+  std::vector< int32_t > mTicks;
+  std::vector< uint64_t > mPids;
+  std::vector< uint16_t > mStates;
+  std::vector< uint64_t > mContacts;
+  std::vector< uint64_t > mLocations;
+};
+
+#endif /* SRC_ACTIONS_CTRANSITIONBLOCK_H_ */
@@ -26,6 +26,8 @@
 #include "actions/COperation.h"
 #include "diseaseModel/CTransmission.h"
 #include "diseaseModel/CHealthState.h"
+#include "diseaseModel/CModel.h"
+#include "network/CNetwork.h"
 #include "network/CNode.h"
 #include "network/CEdge.h"
 #include "utilities/CMetadata.h"
@@ -70,7 +72,7 @@ bool CTransmissionAction::execute() const
       if (CValueInterface(pTarget->healthState) == mStateAtScheduleTime)
         {
           CMetadata Info("StateChange", true);
-          Info.set("ContactNode", (int) mpEdge->pSource->id);
+          Info.set("ContactNode", (int) CNetwork::OriginalPid(mpEdge->source()));
 
           if (CEdge::HasLocationId)
             {
@@ -88,3 +90,48 @@ bool CTransmissionAction::execute() const
 
   return success;
 }
+
+void CTransmissionAction::toBinary(std::ostream & os) const
+{
+  size_t Index = mpTransmission - CModel::GetTransmissions().data();
+  size_t Offset = mpEdge - mpTarget->Edges;
+
+  os << 'T';
+  os.write(reinterpret_cast< const char * >(&Index), sizeof(size_t));
+  os.write(reinterpret_cast< const char * >(&mpTarget->id), sizeof(size_t));
+  os.write(reinterpret_cast< const char * >(&Offset), sizeof(size_t));
+  mStateAtScheduleTime.toBinary(os);
+}
+
+// static
+CAction * CTransmissionAction::fromBinary(std::istream & is)
+{
+  size_t Index;
+  size_t NodeId;
+  size_t Offset;
+
+  is.read(reinterpret_cast< char * >(&Index), sizeof(size_t));
+  is.read(reinterpret_cast< char * >(&NodeId), sizeof(size_t));
+  is.read(reinterpret_cast< char * >(&Offset), sizeof(size_t));
+
+  if (is.fail()
+      || Index >= CModel::GetTransmissions().size())
+    return NULL;
+
+  const CNode * pTarget = CNetwork::Context.Master().lookupNode(NodeId, true);
+
+  if (pTarget == NULL
+      || Offset >= pTarget->EdgesSize)
+    return NULL;
+
+  CTransmissionAction * pAction = new CTransmissionAction(CModel::GetTransmissions().data() + Index, pTarget, pTarget->Edges + Offset);
+  pAction->mStateAtScheduleTime.fromBinary(is);
+
+  if (is.fail())
+    {
+      delete pAction;
+      return NULL;
+    }
+
+  return pAction;
+}
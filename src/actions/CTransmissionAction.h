@@ -47,6 +47,10 @@ public:
   
   virtual bool execute() const override;
 
+  virtual void toBinary(std::ostream & os) const override;
+
+  static CAction * fromBinary(std::istream & is);
+
 private:
   const CTransmission * mpTransmission;
   const CNode * mpTarget;
@@ -45,3 +45,27 @@ bool CVariableAction::execute() const
 {
   return mpDefinition->execute();
 }
+
+void CVariableAction::toBinary(std::ostream & os) const
+{
+  os << 'V';
+  os.write(reinterpret_cast< const char * >(&mpDefinition->getIndex()), sizeof(size_t));
+}
+
+// static
+CAction * CVariableAction::fromBinary(std::istream & is)
+{
+  size_t Index;
+
+  is.read(reinterpret_cast< char * >(&Index), sizeof(size_t));
+
+  if (is.fail())
+    return NULL;
+
+  const CActionDefinition * pDefinition = CActionDefinition::GetActionDefinition(Index);
+
+  if (pDefinition == NULL)
+    return NULL;
+
+  return new CVariableAction(pDefinition);
+}
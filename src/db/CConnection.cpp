@@ -41,7 +41,8 @@ void CConnection::setRequired(const bool & isRequired)
 void CConnection::init()
 {
   if (pINSTANCE != NULL
-      || !required)
+      || !required
+      || CSimConfig::getDBConnection().backend == "memory")
     return;
 
   const CSimConfig::db_connection & dbConnection = CSimConfig::getDBConnection();
@@ -0,0 +1,720 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <jansson.h>
+
+#include "db/CMemoryDB.h"
+#include "db/CSchema.h"
+#include "db/CFieldValue.h"
+#include "db/CFieldValueList.h"
+#include "network/CNetwork.h"
+#include "network/CNode.h"
+#include "utilities/CDirEntry.h"
+#include "utilities/CSimConfig.h"
+#include "utilities/CLogger.h"
+
+// Split a CSV line into its fields and remove enclosing quotes.
+static void splitLine(const std::string & line, std::vector< std::string > & fields)
+{
+  fields.clear();
+
+  std::string::size_type Begin = 0;
+  std::string::size_type End = line.size();
+
+  if (End > 0 && line[End - 1] == '\r')
+    --End;
+
+  while (Begin <= End)
+    {
+      std::string::size_type Comma = line.find(',', Begin);
+
+      if (Comma == std::string::npos || Comma > End)
+        Comma = End;
+
+      std::string::size_type First = Begin;
+      std::string::size_type Last = Comma;
+
+      if (Last - First >= 2 && line[First] == '"' && line[Last - 1] == '"')
+        {
+          ++First;
+          --Last;
+        }
+
+      fields.push_back(line.substr(First, Last - First));
+      Begin = Comma + 1;
+    }
+}
+
+static bool parseCell(const std::string & cell, CValueInterface::Type type, std::map< std::string, size_t > & codes,
+                      std::vector< char > & present, std::vector< size_t > & ids, std::vector< int > & integers,
+                      std::vector< double > & numbers, std::vector< size_t > & stringCodes, std::vector< std::string > & dictionary)
+{
+  present.push_back(!cell.empty());
+
+  const char * pBegin = cell.c_str();
+  char * pEnd = const_cast< char * >(pBegin);
+
+  switch (type)
+    {
+    case CValueInterface::Type::id:
+      ids.push_back(cell.empty() ? 0 : strtoull(pBegin, &pEnd, 10));
+      break;
+
+    case CValueInterface::Type::integer:
+      integers.push_back(cell.empty() ? 0 : strtol(pBegin, &pEnd, 10));
+      break;
+
+    case CValueInterface::Type::number:
+      numbers.push_back(cell.empty() ? std::numeric_limits< double >::quiet_NaN() : strtod(pBegin, &pEnd));
+      break;
+
+    case CValueInterface::Type::string:
+      {
+        std::map< std::string, size_t >::const_iterator found = codes.find(cell);
+
+        if (found == codes.end())
+          {
+            found = codes.emplace(cell, dictionary.size()).first;
+            dictionary.push_back(cell);
+          }
+
+        stringCodes.push_back(found->second);
+        return true;
+      }
+      break;
+
+    default:
+      return false;
+      break;
+    }
+
+  return cell.empty() || *pEnd == 0;
+}
+
+template < class Type >
+static void permute(std::vector< Type > & values, const std::vector< size_t > & order)
+{
+  if (values.empty())
+    return;
+
+  std::vector< Type > Sorted;
+  Sorted.reserve(order.size());
+
+  for (const size_t & Index : order)
+    Sorted.push_back(values[Index]);
+
+  values.swap(Sorted);
+}
+
+template < class Type, class Compare >
+static void scan(const Type * pValue, const char * pPresent, const Type & constraint, Compare compare, std::vector< char > & mask)
+{
+  char * pMask = mask.data();
+  char * pMaskEnd = pMask + mask.size();
+
+  for (; pMask != pMaskEnd; ++pMask, ++pValue, ++pPresent)
+    *pMask = *pPresent && compare(*pValue, constraint);
+}
+
+template < class Type >
+static bool scanWhere(const std::vector< Type > & values, const std::vector< char > & present, const size_t & begin, const Type & constraint, const std::string & cmp, std::vector< char > & mask)
+{
+  const Type * pValue = values.data() + begin;
+  const char * pPresent = present.data() + begin;
+
+  if (cmp == "=")
+    scan(pValue, pPresent, constraint, std::equal_to< Type >(), mask);
+  else if (cmp == "<>")
+    scan(pValue, pPresent, constraint, std::not_equal_to< Type >(), mask);
+  else if (cmp == "<=")
+    scan(pValue, pPresent, constraint, std::less_equal< Type >(), mask);
+  else if (cmp == "<")
+    scan(pValue, pPresent, constraint, std::less< Type >(), mask);
+  else if (cmp == ">=")
+    scan(pValue, pPresent, constraint, std::greater_equal< Type >(), mask);
+  else if (cmp == ">")
+    scan(pValue, pPresent, constraint, std::greater< Type >(), mask);
+  else
+    {
+      CLogger::error("CMemoryDB::where: Invalid comparison '{}'.", cmp);
+      return false;
+    }
+
+  return true;
+}
+
+template < class Type >
+static void scanIn(const std::vector< Type > & values, const std::vector< char > & present, const size_t & begin, std::vector< Type > & constraints, const bool & in, std::vector< char > & mask)
+{
+  std::sort(constraints.begin(), constraints.end());
+
+  const Type * pValue = values.data() + begin;
+  const char * pPresent = present.data() + begin;
+  char * pMask = mask.data();
+  char * pMaskEnd = pMask + mask.size();
+
+  for (; pMask != pMaskEnd; ++pMask, ++pValue, ++pPresent)
+    *pMask = *pPresent && std::binary_search(constraints.begin(), constraints.end(), *pValue) == in;
+}
+
+// static
+std::map< std::string, CMemoryDB::sTable > CMemoryDB::Tables;
+
+// static
+bool CMemoryDB::Enabled(false);
+
+// static
+bool CMemoryDB::isEnabled()
+{
+  return Enabled;
+}
+
+// static
+bool CMemoryDB::load(const std::vector< std::string > & personTraitDBs)
+{
+  clear();
+
+  if (CSimConfig::getDBConnection().backend != "memory")
+    return true;
+
+  bool success = true;
+  std::vector< std::string >::const_iterator it = personTraitDBs.begin();
+  std::vector< std::string >::const_iterator end = personTraitDBs.end();
+
+  for (; it != end && success; ++it)
+    success &= loadTable(*it);
+
+  Enabled = success;
+
+  return success;
+}
+
+// static
+void CMemoryDB::clear()
+{
+  Tables.clear();
+  Enabled = false;
+}
+
+// static
+bool CMemoryDB::loadTable(const std::string & personTraitDB)
+{
+  json_t * pRoot = CSimConfig::loadJsonPreamble(personTraitDB, JSON_DECODE_INT_AS_REAL);
+
+  if (pRoot == NULL)
+    return false;
+
+  std::string Name;
+  std::string Path;
+  json_t * pValue = json_object_get(pRoot, "name");
+
+  if (json_is_string(pValue))
+    Name = json_string_value(pValue);
+
+  pValue = json_object_get(pRoot, "path");
+
+  if (json_is_string(pValue))
+    Path = json_string_value(pValue);
+
+  json_decref(pRoot);
+
+  const CTable & Table = CSchema::INSTANCE.getTable(Name);
+
+  if (!Table.isValid())
+    {
+      CLogger::error("CMemoryDB: Invalid table '{}' in '{}'.", Name, personTraitDB);
+      return false;
+    }
+
+  if (Tables.find(Name) != Tables.end())
+    {
+      CLogger::error("CMemoryDB: Duplicate table '{}' in '{}'.", Name, personTraitDB);
+      return false;
+    }
+
+  std::string DataFile = personTraitDB;
+  std::ifstream is(DataFile.c_str());
+  std::string Line;
+
+  // Skip the JSON preamble. If no data follow we read the file specified by 'path'.
+  std::getline(is, Line);
+
+  if (!std::getline(is, Line) || Line.empty())
+    {
+      if (Path.empty())
+        {
+          CLogger::error("CMemoryDB: Missing data for table '{}' in '{}'.", Name, personTraitDB);
+          return false;
+        }
+
+      is.close();
+      DataFile = Path;
+      CDirEntry::makePathAbsolute(DataFile, personTraitDB);
+      is.clear();
+      is.open(DataFile.c_str());
+
+      if (is.fail() || !std::getline(is, Line))
+        {
+          CLogger::error("CMemoryDB: Data file '{}' for table '{}' cannot be read.", DataFile, Name);
+          return false;
+        }
+    }
+
+  sTable & MemoryTable = Tables[Name];
+  std::vector< std::string > Header;
+  splitLine(Line, Header);
+
+  size_t PidIndex = Header.size();
+  std::vector< sColumn * > Columns(Header.size(), NULL);
+  std::vector< std::map< std::string, size_t > > Codes(Header.size());
+
+  for (size_t i = 0; i < Header.size(); ++i)
+    {
+      if (Header[i] == "pid")
+        {
+          PidIndex = i;
+          continue;
+        }
+
+      const CField & Field = Table.getField(Header[i]);
+
+      // Columns which are not part of the schema can never be queried.
+      if (!Field.isValid())
+        continue;
+
+      Columns[i] = &MemoryTable.columns[Header[i]];
+      Columns[i]->type = Field.getType();
+    }
+
+  if (PidIndex == Header.size())
+    {
+      CLogger::error("CMemoryDB: Missing column 'pid' in '{}'.", DataFile);
+      return false;
+    }
+
+  const CNetwork & Network = CNetwork::Context.Master();
+  std::vector< std::string > Fields;
+  size_t LineNumber = 1;
+  size_t Rows = 0;
+
+  while (std::getline(is, Line))
+    {
+      ++LineNumber;
+
+      if (Line.empty() || Line == "\r")
+        continue;
+
+      ++Rows;
+      splitLine(Line, Fields);
+
+      if (Fields.size() != Columns.size())
+        {
+          CLogger::error("CMemoryDB: Invalid number of columns in '{}' line '{}'.", DataFile, LineNumber);
+          return false;
+        }
+
+      char * pEnd = NULL;
+      size_t Pid = strtoull(Fields[PidIndex].c_str(), &pEnd, 10);
+
+      if (Fields[PidIndex].empty() || *pEnd != 0)
+        {
+          CLogger::error("CMemoryDB: Invalid pid in '{}' line '{}'.", DataFile, LineNumber);
+          return false;
+        }
+
+      // We only keep the rows of nodes known to this rank.
+      if (Network.lookupOriginalPid(Pid, false) == NULL)
+        continue;
+
+      MemoryTable.pids.push_back(Pid);
+
+      for (size_t i = 0; i < Columns.size(); ++i)
+        {
+          sColumn * pColumn = Columns[i];
+
+          if (pColumn == NULL)
+            continue;
+
+          if (!parseCell(Fields[i], pColumn->type, Codes[i], pColumn->present, pColumn->ids, pColumn->integers, pColumn->numbers, pColumn->codes, pColumn->dictionary))
+            {
+              CLogger::error("CMemoryDB: Invalid value '{}' for '{}' in '{}' line '{}'.", Fields[i], Header[i], DataFile, LineNumber);
+              return false;
+            }
+        }
+    }
+
+  if (!std::is_sorted(MemoryTable.pids.begin(), MemoryTable.pids.end()))
+    {
+      std::vector< size_t > Order(MemoryTable.pids.size());
+
+      for (size_t i = 0; i < Order.size(); ++i)
+        Order[i] = i;
+
+      std::sort(Order.begin(), Order.end(), [&MemoryTable](const size_t & lhs, const size_t & rhs) {
+        return MemoryTable.pids[lhs] < MemoryTable.pids[rhs];
+      });
+
+      permute(MemoryTable.pids, Order);
+
+      for (std::pair< const std::string, sColumn > & Column : MemoryTable.columns)
+        {
+          permute(Column.second.present, Order);
+          permute(Column.second.ids, Order);
+          permute(Column.second.integers, Order);
+          permute(Column.second.numbers, Order);
+          permute(Column.second.codes, Order);
+        }
+    }
+
+  CLogger::info("CMemoryDB: Loaded '{}' of '{}' rows of table '{}'.", MemoryTable.pids.size(), Rows, Name);
+
+  return true;
+}
+
+// static
+const CMemoryDB::sTable * CMemoryDB::getTable(const std::string & table, const std::string & resultField, const std::string & constraintField)
+{
+  std::map< std::string, sTable >::const_iterator found = Tables.find(table);
+
+  if (found == Tables.end())
+    {
+      CLogger::error("CMemoryDB: Table '{}' is not loaded.", table);
+      return NULL;
+    }
+
+  if (resultField != "pid"
+      && found->second.columns.find(resultField) == found->second.columns.end())
+    {
+      CLogger::error("CMemoryDB: Missing column '{}' in table '{}'.", resultField, table);
+      return NULL;
+    }
+
+  if (!constraintField.empty()
+      && constraintField != "pid"
+      && found->second.columns.find(constraintField) == found->second.columns.end())
+    {
+      CLogger::error("CMemoryDB: Missing column '{}' in table '{}'.", constraintField, table);
+      return NULL;
+    }
+
+  return &found->second;
+}
+
+// static
+void CMemoryDB::range(const sTable & table, const bool & local, size_t & begin, size_t & end)
+{
+  begin = 0;
+  end = table.pids.size();
+
+  // The original PIDs of a relabeled partition are not a range, the local rows are selected by maskLocal.
+  if (!local
+      || CNetwork::HaveOriginalPids())
+    return;
+
+  // The local rows are those of the nodes of the active (thread) network.
+  CNetwork & Active = CNetwork::Context.Active();
+
+  if (Active.beginNode() == Active.endNode())
+    {
+      end = 0;
+      return;
+    }
+
+  begin = std::lower_bound(table.pids.begin(), table.pids.end(), Active.beginNode()->id) - table.pids.begin();
+  end = std::upper_bound(table.pids.begin() + begin, table.pids.end(), (Active.endNode() - 1)->id) - table.pids.begin();
+}
+
+// static
+void CMemoryDB::maskLocal(const sTable & table, const bool & local, const size_t & begin, std::vector< char > & mask)
+{
+  if (!local
+      || !CNetwork::HaveOriginalPids())
+    return;
+
+  const CNetwork & Active = CNetwork::Context.Active();
+
+  for (size_t i = 0; i < mask.size(); ++i)
+    if (mask[i]
+        && Active.lookupOriginalPid(table.pids[begin + i], true) == NULL)
+      mask[i] = 0;
+}
+
+// static
+void CMemoryDB::collect(const sTable & table, const std::string & resultField, const std::vector< char > & mask, const size_t & begin, CFieldValueList & result)
+{
+  if (resultField == "pid")
+    {
+      for (size_t i = 0; i < mask.size(); ++i)
+        if (mask[i])
+          result.append(CFieldValue(table.pids[begin + i]));
+
+      return;
+    }
+
+  const sColumn & Column = table.columns.find(resultField)->second;
+
+  switch (Column.type)
+    {
+    case CValueInterface::Type::id:
+      for (size_t i = 0; i < mask.size(); ++i)
+        if (mask[i] && Column.present[begin + i])
+          result.append(CFieldValue(Column.ids[begin + i]));
+      break;
+
+    case CValueInterface::Type::integer:
+      for (size_t i = 0; i < mask.size(); ++i)
+        if (mask[i] && Column.present[begin + i])
+          result.append(CFieldValue(Column.integers[begin + i]));
+      break;
+
+    case CValueInterface::Type::number:
+      for (size_t i = 0; i < mask.size(); ++i)
+        if (mask[i] && Column.present[begin + i])
+          result.append(CFieldValue(Column.numbers[begin + i]));
+      break;
+
+    case CValueInterface::Type::string:
+      {
+        std::vector< char > Used(Column.dictionary.size(), 0);
+
+        for (size_t i = 0; i < mask.size(); ++i)
+          if (mask[i] && Column.present[begin + i])
+            Used[Column.codes[begin + i]] = 1;
+
+        for (size_t i = 0; i < Used.size(); ++i)
+          if (Used[i])
+            result.append(CFieldValue(Column.dictionary[i]));
+      }
+      break;
+
+    default:
+      break;
+    }
+}
+
+// static
+bool CMemoryDB::all(const std::string & table,
+                    const std::string & resultField,
+                    CFieldValueList & result,
+                    const bool & local)
+{
+  const sTable * pTable = getTable(table, resultField, "");
+
+  if (pTable == NULL)
+    return false;
+
+  size_t Begin;
+  size_t End;
+  range(*pTable, local, Begin, End);
+
+  std::vector< char > Mask(End - Begin, 1);
+  maskLocal(*pTable, local, Begin, Mask);
+  collect(*pTable, resultField, Mask, Begin, result);
+
+  CLogger::debug("CMemoryDB::all: {} returned '{}' rows.", table, result.size());
+
+  return true;
+}
+
+// static
+bool CMemoryDB::in(const std::string & table,
+                   const std::string & resultField,
+                   CFieldValueList & result,
+                   const bool & local,
+                   const std::string & constraintField,
+                   const CValueList & constraints,
+                   const bool & in)
+{
+  const sTable * pTable = getTable(table, resultField, constraintField);
+
+  if (pTable == NULL)
+    return false;
+
+  size_t Begin;
+  size_t End;
+  range(*pTable, local, Begin, End);
+
+  std::vector< char > Mask(End - Begin, in ? 0 : 1);
+
+  if (constraintField == "pid")
+    {
+      // The rows are sorted by pid and so are the constraints.
+      std::vector< size_t >::const_iterator itBegin = pTable->pids.begin() + Begin;
+      std::vector< size_t >::const_iterator itEnd = pTable->pids.begin() + End;
+      std::vector< size_t >::const_iterator itRow = itBegin;
+
+      CValueList::const_iterator it = constraints.begin();
+      CValueList::const_iterator end = constraints.end();
+
+      for (; it != end && itRow != itEnd; ++it)
+        {
+          itRow = std::lower_bound(itRow, itEnd, it->toId());
+
+          if (itRow != itEnd && *itRow == it->toId())
+            Mask[itRow - itBegin] = in;
+        }
+    }
+  else
+    {
+      const sColumn & Column = pTable->columns.find(constraintField)->second;
+
+      switch (Column.type)
+        {
+        case CValueInterface::Type::id:
+          {
+            std::vector< size_t > Values;
+
+            for (const CValue & Value : constraints)
+              Values.push_back(Value.toId());
+
+            scanIn(Column.ids, Column.present, Begin, Values, in, Mask);
+          }
+          break;
+
+        case CValueInterface::Type::integer:
+          {
+            std::vector< int > Values;
+
+            for (const CValue & Value : constraints)
+              Values.push_back(Value.toInteger());
+
+            scanIn(Column.integers, Column.present, Begin, Values, in, Mask);
+          }
+          break;
+
+        case CValueInterface::Type::number:
+          {
+            std::vector< double > Values;
+
+            for (const CValue & Value : constraints)
+              Values.push_back(Value.toNumber());
+
+            scanIn(Column.numbers, Column.present, Begin, Values, in, Mask);
+          }
+          break;
+
+        case CValueInterface::Type::string:
+          {
+            // The constraints are evaluated once per dictionary entry.
+            std::vector< char > Selected(Column.dictionary.size());
+
+            for (size_t i = 0; i < Selected.size(); ++i)
+              Selected[i] = constraints.contains(CFieldValue(Column.dictionary[i])) == in;
+
+            for (size_t i = 0; i < Mask.size(); ++i)
+              Mask[i] = Column.present[Begin + i] && Selected[Column.codes[Begin + i]];
+          }
+          break;
+
+        default:
+          return false;
+          break;
+        }
+    }
+
+  maskLocal(*pTable, local, Begin, Mask);
+  collect(*pTable, resultField, Mask, Begin, result);
+
+  CLogger::debug("CMemoryDB::{}: {} returned '{}' rows.", in ? "in" : "notIn", table, result.size());
+
+  return true;
+}
+
+// static
+bool CMemoryDB::where(const std::string & table,
+                      const std::string & resultField,
+                      CFieldValueList & result,
+                      const bool & local,
+                      const std::string & constraintField,
+                      const CValueInterface & constraint,
+                      const std::string & cmp)
+{
+  const sTable * pTable = getTable(table, resultField, constraintField);
+
+  if (pTable == NULL)
+    return false;
+
+  size_t Begin;
+  size_t End;
+  range(*pTable, local, Begin, End);
+
+  std::vector< char > Mask(End - Begin, 0);
+  bool success = true;
+
+  if (constraintField == "pid")
+    {
+      std::vector< char > Present(pTable->pids.size(), 1);
+      success = scanWhere(pTable->pids, Present, Begin, constraint.toId(), cmp, Mask);
+    }
+  else
+    {
+      const sColumn & Column = pTable->columns.find(constraintField)->second;
+
+      switch (Column.type)
+        {
+        case CValueInterface::Type::id:
+          success = scanWhere(Column.ids, Column.present, Begin, constraint.toId(), cmp, Mask);
+          break;
+
+        case CValueInterface::Type::integer:
+          success = scanWhere(Column.integers, Column.present, Begin, constraint.toInteger(), cmp, Mask);
+          break;
+
+        case CValueInterface::Type::number:
+          success = scanWhere(Column.numbers, Column.present, Begin, constraint.toNumber(), cmp, Mask);
+          break;
+
+        case CValueInterface::Type::string:
+          {
+            // The comparison is evaluated once per dictionary entry.
+            std::vector< char > Present(Column.dictionary.size(), 1);
+            std::vector< char > Selected(Column.dictionary.size());
+            success = scanWhere(Column.dictionary, Present, 0, constraint.toString(), cmp, Selected);
+
+            for (size_t i = 0; i < Mask.size(); ++i)
+              Mask[i] = Column.present[Begin + i] && Selected[Column.codes[Begin + i]];
+          }
+          break;
+
+        default:
+          success = false;
+          break;
+        }
+    }
+
+  if (success)
+    {
+      maskLocal(*pTable, local, Begin, Mask);
+      collect(*pTable, resultField, Mask, Begin, result);
+    }
+
+  CLogger::debug("CMemoryDB::where: {} {} {} returned '{}' rows.", table, constraintField, cmp, result.size());
+
+  return success;
+}
@@ -0,0 +1,115 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_DB_CMEMORYDB_H_
+#define SRC_DB_CMEMORYDB_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "math/CValueInterface.h"
+
+class CValueList;
+class CFieldValueList;
+
+/**
+ * An in memory columnar copy of the person trait DB, used instead of PostgreSQL if the
+ * run parameter dbBackend is memory.
+ *
+ * Each rank reads the person trait DB files once after the network is loaded and keeps the rows
+ * of the nodes it knows, i.e., its local and remote nodes. The rows of a table are sorted by pid
+ * and each field is stored in a typed column. String fields are dictionary encoded. The queries of
+ * CQuery are evaluated as scans over these columns. The store is read only after loading and
+ * is therefore queried concurrently by all threads without locking.
+ */
+class CMemoryDB
+{
+public:
+  static bool isEnabled();
+
+  /**
+   * Load the tables of the person trait DB files. The CSV data either follows the JSON preamble
+   * or is read from the file specified by the preamble's 'path'.
+   * @param const std::vector< std::string > & personTraitDBs
+   * @return bool success
+   */
+  static bool load(const std::vector< std::string > & personTraitDBs);
+
+  static void clear();
+
+  static bool all(const std::string & table,
+                  const std::string & resultField,
+                  CFieldValueList & result,
+                  const bool & local);
+
+  static bool in(const std::string & table,
+                 const std::string & resultField,
+                 CFieldValueList & result,
+                 const bool & local,
+                 const std::string & constraintField,
+                 const CValueList & constraints,
+                 const bool & in);
+
+  static bool where(const std::string & table,
+                    const std::string & resultField,
+                    CFieldValueList & result,
+                    const bool & local,
+                    const std::string & constraintField,
+                    const CValueInterface & constraint,
+                    const std::string & cmp);
+
+private:
+  struct sColumn
+  {
+    CValueInterface::Type type;
+    std::vector< char > present;
+    std::vector< size_t > ids;
+    std::vector< int > integers;
+    std::vector< double > numbers;
+    std::vector< size_t > codes;
+    std::vector< std::string > dictionary;
+  };
+
+  struct sTable
+  {
+    std::vector< size_t > pids;
+    std::map< std::string, sColumn > columns;
+  };
+
+  static bool loadTable(const std::string & personTraitDB);
+
+  static const sTable * getTable(const std::string & table, const std::string & resultField, const std::string & constraintField);
+
+  static void range(const sTable & table, const bool & local, size_t & begin, size_t & end);
+
+  static void maskLocal(const sTable & table, const bool & local, const size_t & begin, std::vector< char > & mask);
+
+  static void collect(const sTable & table, const std::string & resultField, const std::vector< char > & mask, const size_t & begin, CFieldValueList & result);
+
+  static std::map< std::string, sTable > Tables;
+  static bool Enabled;
+};
+
+#endif /* SRC_DB_CMEMORYDB_H_ */
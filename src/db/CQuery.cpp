@@ -23,12 +23,14 @@
 // END: Copyright 
 
 #include <sstream>
+#include <algorithm>
 
 #include "db/CQuery.h"
 #include "db/CConnection.h"
 #include "db/CSchema.h"
 #include "db/CFieldValueList.h"
 #include "db/CFieldValue.h"
+#include "db/CMemoryDB.h"
 #include "network/CNetwork.h"
 #include "network/CNode.h"
 #include "utilities/CSimConfig.h"
@@ -111,6 +113,44 @@ size_t toFieldValueList(const CField & field, const pqxx::result & result, CFiel
   return 0;
 }
 
+// The pids are sorted and consecutive runs of pids are combined into ranges.
+std::string toPidConstraint(const std::vector< size_t > & pids)
+{
+  if (pids.empty())
+    return "FALSE";
+
+  std::ostringstream Ranges;
+  std::ostringstream List;
+  std::vector< size_t >::const_iterator it = pids.begin();
+  std::vector< size_t >::const_iterator end = pids.end();
+
+  while (it != end)
+    {
+      std::vector< size_t >::const_iterator last = it;
+
+      while (last + 1 != end && *(last + 1) == *last + 1)
+        ++last;
+
+      if (last - it >= 2)
+        Ranges << (Ranges.tellp() > 0 ? " OR " : "") << "pid BETWEEN " << *it << " AND " << *last;
+      else
+        for (; it != last + 1; ++it)
+          List << (List.tellp() > 0 ? ", " : "") << *it;
+
+      it = last + 1;
+    }
+
+  std::ostringstream Constraint;
+  Constraint << "(" << Ranges.str();
+
+  if (List.tellp() > 0)
+    Constraint << (Ranges.tellp() > 0 ? " OR " : "") << "pid IN (" << List.str() << ")";
+
+  Constraint << ")";
+
+  return Constraint.str();
+}
+
 // static
 CContext< std::string > CQuery::LocalConstraint = CContext< std::string >();
 
@@ -134,6 +174,22 @@ void CQuery::init()
 
   if (Active.empty())
     {
+      // The original PIDs of a relabeled partition are not a single range.
+      if (CNetwork::HaveOriginalPids())
+        {
+          std::vector< size_t > Pids;
+          CNode * pNode = CNetwork::Context.Active().beginNode();
+          CNode * pNodeEnd = CNetwork::Context.Active().endNode();
+
+          for (; pNode != pNodeEnd; ++pNode)
+            Pids.push_back(CNetwork::OriginalPid(pNode));
+
+          std::sort(Pids.begin(), Pids.end());
+          Active = toPidConstraint(Pids);
+
+          return;
+        }
+
       std::ostringstream Query;
 
       CNode * pBegin = CNetwork::Context.Active().beginNode();
@@ -181,6 +237,9 @@ bool CQuery::all(const std::string & table,
   if (!ResultField.isValid())
     return false;
 
+  if (CMemoryDB::isEnabled())
+    return CMemoryDB::all(table, resultField, result, local);
+
   std::ostringstream Query;
   Query << "SELECT DISTINCT " << CConnection::quote(resultField) << " FROM " << CConnection::quote(table);
 
@@ -293,6 +352,9 @@ bool CQuery::in(const std::string & table,
           }
     }
 
+  if (CMemoryDB::isEnabled())
+    return CMemoryDB::in(table, resultField, result, local, constraintField, constraints, in);
+
   std::ostringstream Query;
 
   Query << "SELECT DISTINCT " << CConnection::quote(resultField) << " FROM " << CConnection::quote(table) << " WHERE " << CConnection::quote(constraintField) << ((!in) ? " NOT  IN (" : " IN (");
@@ -441,6 +503,9 @@ bool CQuery::where(const std::string & table,
       return false;
     }
 
+  if (CMemoryDB::isEnabled())
+    return CMemoryDB::where(table, resultField, result, local, constraintField, constraint, cmp);
+
   std::ostringstream Query;
   Query << "SELECT DISTINCT " << CConnection::quote(resultField) << " FROM " << CConnection::quote(table) << " WHERE " << CConnection::quote(constraintField) << " " << cmp << " ";
 
@@ -0,0 +1,195 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include "db/CQueryCache.h"
+#include "math/CValue.h"
+#include "utilities/CLogger.h"
+
+CQueryCache::Key::Key(const std::string & table,
+                      const std::string & field,
+                      const std::string & operation,
+                      const bool & local)
+  : table(table)
+  , field(field)
+  , operation(operation)
+  , local(local)
+  , values()
+{}
+
+CQueryCache::Key::Key(const std::string & table,
+                      const std::string & field,
+                      const std::string & operation,
+                      const bool & local,
+                      const CValueList & values)
+  : table(table)
+  , field(field)
+  , operation(operation)
+  , local(local)
+  , values(values)
+{}
+
+CQueryCache::Key::Key(const std::string & table,
+                      const std::string & field,
+                      const std::string & operation,
+                      const bool & local,
+                      const CValueInterface & value)
+  : table(table)
+  , field(field)
+  , operation(operation)
+  , local(local)
+  , values(value.getType())
+{
+  switch (value.getType())
+    {
+    case CValueInterface::Type::id:
+      values.append(CValue(value.toId()));
+      break;
+
+    case CValueInterface::Type::integer:
+      values.append(CValue(value.toInteger()));
+      break;
+
+    case CValueInterface::Type::number:
+      values.append(CValue(value.toNumber()));
+      break;
+
+    case CValueInterface::Type::string:
+      values.append(CValue(value.toString()));
+      break;
+
+    case CValueInterface::Type::boolean:
+      values.append(CValue(value.toBoolean()));
+      break;
+
+    case CValueInterface::Type::traitData:
+    case CValueInterface::Type::traitValue:
+    case CValueInterface::Type::__SIZE:
+      break;
+    }
+}
+
+bool CQueryCache::Key::operator < (const Key & rhs) const
+{
+  if (table != rhs.table)
+    return table < rhs.table;
+
+  if (field != rhs.field)
+    return field < rhs.field;
+
+  if (operation != rhs.operation)
+    return operation < rhs.operation;
+
+  if (local != rhs.local)
+    return local < rhs.local;
+
+  if (values.getType() != rhs.values.getType())
+    return values.getType() < rhs.values.getType();
+
+  return static_cast< const CValueList::base & >(values) < static_cast< const CValueList::base & >(rhs.values);
+}
+
+// static
+const size_t CQueryCache::MaxEntries = 1024;
+
+// static
+CContext< CQueryCache::sCache > CQueryCache::Context;
+
+// static
+void CQueryCache::init()
+{
+  Context.init();
+}
+
+// static
+bool CQueryCache::lookup(const Key & key, std::vector< CNode * > & nodes)
+{
+  if (Context.size() == 0)
+    return false;
+
+  sCache & Cache = Context.Active();
+  std::map< Key, std::vector< CNode * > >::const_iterator found = Cache.entries.find(key);
+
+  if (found == Cache.entries.end())
+    {
+      ++Cache.misses;
+      return false;
+    }
+
+  ++Cache.hits;
+  nodes = found->second;
+
+  return true;
+}
+
+// static
+void CQueryCache::insert(const Key & key, const std::vector< CNode * > & nodes)
+{
+  if (Context.size() == 0)
+    return;
+
+  sCache & Cache = Context.Active();
+
+  // Queries with changing constraints, e.g., observables, must not grow the cache without bound.
+  if (Cache.entries.size() >= MaxEntries)
+    Cache.entries.clear();
+
+  Cache.entries[key] = nodes;
+}
+
+// static
+void CQueryCache::report()
+{
+  if (Context.size() == 0)
+    return;
+
+  size_t Hits = 0;
+  size_t Misses = 0;
+  size_t Entries = 0;
+
+  // Queries outside of parallel regions use the master cache.
+  if (!Context.isThread(&Context.Master()))
+    {
+      Hits += Context.Master().hits;
+      Misses += Context.Master().misses;
+      Entries += Context.Master().entries.size();
+    }
+
+  sCache * pIt = Context.beginThread();
+  sCache * pEnd = Context.endThread();
+
+  for (; pIt != pEnd; ++pIt)
+    {
+      Hits += pIt->hits;
+      Misses += pIt->misses;
+      Entries += pIt->entries.size();
+    }
+
+  CLogger::info("CQueryCache: hits = '{}', misses = '{}', entries = '{}'.", Hits, Misses, Entries);
+}
+
+// static
+void CQueryCache::clear()
+{
+  Context.release();
+}
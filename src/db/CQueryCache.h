@@ -0,0 +1,112 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_DB_CQUERYCACHE_H_
+#define SRC_DB_CQUERYCACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "math/CValueList.h"
+#include "utilities/CContext.h"
+
+class CNode;
+
+/**
+ * A per thread cache of the nodes selected by database queries.
+ *
+ * The person trait DB does not change during a run, i.e., a query returns the same nodes whenever
+ * it is repeated. The nodes are cached for the normalized query, so that all selectors with identical
+ * predicates share the result across ticks. Each thread caches the nodes it resolved, which are
+ * restricted to the thread's partition for local queries.
+ */
+class CQueryCache
+{
+public:
+  struct Key
+  {
+    Key(const std::string & table,
+        const std::string & field,
+        const std::string & operation,
+        const bool & local);
+
+    Key(const std::string & table,
+        const std::string & field,
+        const std::string & operation,
+        const bool & local,
+        const CValueList & values);
+
+    Key(const std::string & table,
+        const std::string & field,
+        const std::string & operation,
+        const bool & local,
+        const CValueInterface & value);
+
+    bool operator < (const Key & rhs) const;
+
+    std::string table;
+    std::string field;
+    std::string operation;
+    bool local;
+    CValueList values;
+  };
+
+  /**
+   * Allocate the per thread caches. This must be called outside of a parallel region.
+   */
+  static void init();
+
+  /**
+   * Retrieve the cached nodes for the query
+   * @param const Key & key
+   * @param std::vector< CNode * > & nodes
+   * @return bool found
+   */
+  static bool lookup(const Key & key, std::vector< CNode * > & nodes);
+
+  static void insert(const Key & key, const std::vector< CNode * > & nodes);
+
+  /**
+   * Log the hit and miss counts of all threads
+   */
+  static void report();
+
+  static void clear();
+
+private:
+  struct sCache
+  {
+    std::map< Key, std::vector< CNode * > > entries;
+    size_t hits = 0;
+    size_t misses = 0;
+  };
+
+  // The maximal number of cached queries per thread.
+  static const size_t MaxEntries;
+
+  static CContext< sCache > Context;
+};
+
+#endif /* SRC_DB_CQUERYCACHE_H_ */
@@ -587,3 +587,57 @@ bool CDistribution::setJson(const std::string & json)
 
   return true;
 }
+
+void CDistribution::toCheckpoint(std::ostream & os) const
+{
+  switch (mType)
+    {
+    case Type::discrete:
+      mUniformReal.toStream(os);
+      break;
+
+    case Type::uniform:
+      mUniformInt.toStream(os);
+      break;
+
+    case Type::normal:
+      mNormal.toStream(os);
+      break;
+
+    case Type::gamma:
+      mGamma.toStream(os);
+      break;
+
+    case Type::fixed:
+    case Type::__NONE:
+      break;
+    }
+}
+
+bool CDistribution::fromCheckpoint(std::istream & is)
+{
+  switch (mType)
+    {
+    case Type::discrete:
+      mUniformReal.fromStream(is);
+      break;
+
+    case Type::uniform:
+      mUniformInt.fromStream(is);
+      break;
+
+    case Type::normal:
+      mNormal.fromStream(is);
+      break;
+
+    case Type::gamma:
+      mGamma.fromStream(is);
+      break;
+
+    case Type::fixed:
+    case Type::__NONE:
+      break;
+    }
+
+  return !is.fail();
+}
@@ -62,6 +62,19 @@ public:
 
   bool setJson(const std::string & json);
 
+  /**
+   * Write the internal state of the sampling distributions, e.g., cached normal deviates
+   * @param std::ostream & os
+   */
+  void toCheckpoint(std::ostream & os) const;
+
+  /**
+   * Restore the internal state of the sampling distributions
+   * @param std::istream & is
+   * @return bool success
+   */
+  bool fromCheckpoint(std::istream & is);
+
 private:
   void normalizeJSON();
 
@@ -23,11 +23,13 @@
 // END: Copyright 
 
 #include <fstream>
+#include <sstream>
 #include <jansson.h>
 
 #include "diseaseModel/CModel.h"
 
 #include "utilities/CSimConfig.h"
+#include "utilities/CAsyncWriter.h"
 #include "diseaseModel/CHealthState.h"
 #include "diseaseModel/CProgression.h"
 #include "diseaseModel/CTransmission.h"
@@ -284,8 +286,7 @@ bool CModel::processTransmissions() const
 
   CRandom::uniform_real Uniform01(0.0, 1.0);
 
-  CNode * pNode = CNetwork::Context.Active().beginNode();
-  CNode * pNodeEnd = CNetwork::Context.Active().endNode();
+  CNode * pNode = NULL;
 
   struct Candidate
   {
@@ -304,30 +305,72 @@ bool CModel::processTransmissions() const
   CTransmission ** pPossibleTransmissions = NULL;
   double Transmissibility = mpTransmissibility->toValue().toNumber();
 
-  for (pNode = CNetwork::Context.Active().beginNode(); pNode != pNodeEnd; ++pNode)
-    if (pNode->susceptibility > 0.0
+  // The structure of arrays mirror is used if enabled
+  CNetwork & Network = CNetwork::Context.Active();
+  const CNetwork::sNodeMirror * pNodeMirror = CNetwork::Context.Master().getNodeMirror();
+  const CNetwork::sEdgeMirror & EdgeMirror = Network.getEdgeMirror();
+  CEdge * pEdges = Network.beginEdge();
+
+  // Only nodes with at least one infectious source may be infected.
+  const std::vector< CNode * > & Frontier = Network.getFrontier();
+  std::vector< CNode * >::const_iterator itNode = Frontier.begin();
+  std::vector< CNode * >::const_iterator endNode = Frontier.end();
+
+  for (; itNode != endNode; ++itNode)
+    if ((pNode = *itNode)->susceptibility > 0.0
         && (pPossibleTransmissions = mPossibleTransmissions[pNode->healthState].Transmissions) != NULL)
       {
-        CEdge * pEdge = pNode->Edges;
-        CEdge * pEdgeEnd = pNode->Edges + pNode->EdgesSize;
-
         CTransmission * pTransmission = NULL;
 
         Candidates.clear();
         double A0 = 0.0;
 
-        for (; pEdge != pEdgeEnd; ++pEdge)
+        if (pNodeMirror != NULL)
           {
-            if (pEdge->active
-                && pEdge->pSource->infectivity > 0.0
-                && (pTransmission = pPossibleTransmissions[pEdge->pSource->healthState]) != NULL)
+            size_t Edge = pNode->Edges - pEdges;
+            size_t EdgeEnd = Edge + pNode->EdgesSize;
+
+            for (; Edge != EdgeEnd; ++Edge)
+              if (EdgeMirror.pActive[Edge])
+                {
+                  const CNetwork::sNodeMirror & Source = pNodeMirror[EdgeMirror.pSource[Edge]];
+
+                  if (Source.infectivity > 0.0
+                      && (pTransmission = pPossibleTransmissions[Source.healthState]) != NULL)
+                    {
+                      // The default method is evaluated in place, the order of operations must match CTransmission::defaultMethod.
+                      double Propensity = pTransmission->hasCustomMethod() ? 
+                                          pTransmission->propensity(pEdges + Edge) : 
+                                          EdgeMirror.pDuration[Edge] * EdgeMirror.pWeight[Edge] * pNode->susceptibility * Source.infectivity * pTransmission->getTransmissibility();
+
+                      if (Propensity > 0.0)
+                        {
+                          A0 += Propensity;
+                          Candidates.emplace_back(pEdges + Edge, pTransmission, Propensity);
+                        }
+                    }
+                }
+          }
+        else
+          {
+            CEdge * pEdge = pNode->Edges;
+            CEdge * pEdgeEnd = pNode->Edges + pNode->EdgesSize;
+
+            for (; pEdge != pEdgeEnd; ++pEdge)
               {
-                double Propensity = pTransmission->propensity(pEdge);
+                const CNode * pSource = pEdge->source();
 
-                if (Propensity > 0.0)
+                if (pEdge->active
+                    && pSource->infectivity > 0.0
+                    && (pTransmission = pPossibleTransmissions[pSource->healthState]) != NULL)
                   {
-                    A0 += Propensity;
-                    Candidates.emplace_back(pEdge, pTransmission, Propensity);
+                    double Propensity = pTransmission->propensity(pEdge);
+
+                    if (Propensity > 0.0)
+                      {
+                        A0 += Propensity;
+                        Candidates.emplace_back(pEdge, pTransmission, Propensity);
+                      }
                   }
               }
           }
@@ -486,30 +529,18 @@ int CModel::UpdateGlobalStateCounts()
           pLocalCount->Out += pIt->Out;
           pIt->Out = 0;
         }
-
-      pState->setGlobalCounts(*pLocalCount);
     }
 
-  CCommunicate::Receive ReceiveCounts(&CModel::ReceiveGlobalStateCounts);
-  CCommunicate::roundRobinFixed(LocalStateCounts, Size * sizeof(CHealthState::Counts), &ReceiveCounts);
+  // The counts consist of size_t only and are reduced as a flat array.
+  int Result = CCommunicate::allreduceSum(reinterpret_cast< size_t * >(LocalStateCounts), Size * sizeof(CHealthState::Counts) / sizeof(size_t));
 
-  return (int) CCommunicate::ErrorCode::Success;
-}
+  pState = INSTANCE->mStates.begin();
+  pLocalCount = LocalStateCounts;
 
-// static
-CCommunicate::ErrorCode CModel::ReceiveGlobalStateCounts(std::istream & is, int /* sender */)
-{
-  CHealthState::Counts Increment;
-  std::vector< CHealthState >::iterator pState = INSTANCE->mStates.begin();
-  std::vector< CHealthState >::iterator pStateEnd = INSTANCE->mStates.end();
-
-  for (; pState != pStateEnd; ++pState)
-    {
-      is.read(reinterpret_cast< char * >(&Increment), sizeof(CHealthState::Counts));
-      pState->incrementGlobalCount(Increment);
-    }
+  for (; pState != pStateEnd; ++pState, ++pLocalCount)
+    pState->setGlobalCounts(*pLocalCount);
 
-  return CCommunicate::ErrorCode::Success;
+  return Result;
 }
 
 // static
@@ -563,6 +594,34 @@ bool CModel::WriteGlobalStateCounts()
 {
   if (CCommunicate::MPIRank == 0)
     {
+      std::ostringstream Line;
+      std::vector< CHealthState >::iterator pState = INSTANCE->mStates.begin();
+      std::vector< CHealthState >::iterator pStateEnd = INSTANCE->mStates.end();
+
+      Line << CActionQueue::getCurrentTick();
+
+      // Loop through all states
+      for (; pState != pStateEnd; ++pState)
+          {
+            const CHealthState::Counts & Counts = pState->getGlobalCounts();
+
+            Line << "," << Counts.Current << "," << Counts.In << "," << Counts.Out;
+          }
+
+      // We also add variables
+      CVariableList::const_iterator it = CVariableList::INSTANCE.begin();
+      CVariableList::const_iterator end = CVariableList::INSTANCE.end();
+
+      for (; it != end; ++it)
+          {
+            Line << "," << (*it)->toValue().toNumber();
+          }
+
+      Line << "," << CRandom::getSeed() << std::endl;
+
+      if (CAsyncWriter::isRunning())
+        return CAsyncWriter::append(CSimConfig::getSummaryOutput(), Line.str());
+
       std::ofstream out;
 
       out.open(CSimConfig::getSummaryOutput().c_str(), std::ios_base::app);
@@ -572,32 +631,8 @@ bool CModel::WriteGlobalStateCounts()
           CLogger::error("CModel::WriteGlobalStateCounts: Failed to open '{}'.", CSimConfig::getSummaryOutput());
           return false;
         }
-      else
-        {
-          std::vector< CHealthState >::iterator pState = INSTANCE->mStates.begin();
-          std::vector< CHealthState >::iterator pStateEnd = INSTANCE->mStates.end();
-
-          out << CActionQueue::getCurrentTick();
 
-          // Loop through all states
-          for (; pState != pStateEnd && out.good(); ++pState)
-              {
-                const CHealthState::Counts & Counts = pState->getGlobalCounts();
-
-                out << "," << Counts.Current << "," << Counts.In << "," << Counts.Out;
-              }
-
-          // We also add variables
-          CVariableList::const_iterator it = CVariableList::INSTANCE.begin();
-          CVariableList::const_iterator end = CVariableList::INSTANCE.end();
-
-          for (; it != end && out.good(); ++it)
-              {
-                out << "," << (*it)->toValue().toNumber();
-              }
-
-          out << "," << CRandom::getSeed() << std::endl;
-        }
+      out << Line.str();
 
       if (out.fail())
         {
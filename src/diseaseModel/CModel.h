@@ -94,8 +94,6 @@ public:
 
   static int UpdateGlobalStateCounts();
 
-  static CCommunicate::ErrorCode ReceiveGlobalStateCounts(std::istream & is, int sender);
-
   static void InitGlobalStateCountOutput();
 
   static bool WriteGlobalStateCounts();
@@ -243,6 +243,11 @@ std::string & CProgression::getDwellTime()
   return mDwellTime.getJson();
 }
 
+CDistribution & CProgression::getDwellTimeDistribution()
+{
+  return mDwellTime;
+}
+
 std::string & CProgression::getSusceptibilityFactorOperation()
 {
   return mSusceptibilityFactorOperation.getJson();
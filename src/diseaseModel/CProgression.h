@@ -68,6 +68,8 @@ public:
 
   std::string & getDwellTime();
 
+  CDistribution & getDwellTimeDistribution();
+
   std::string & getSusceptibilityFactorOperation();
 
   std::string & getInfectivityFactorOperation();
@@ -35,8 +35,8 @@
 double CTransmission::defaultMethod(const CTransmission * pTransmission, const CEdge * pEdge)
 {
   // ρ(P, P', Τi,j,k) = (| contactTime(P, P') ∩ [tn, tn + Δtn] |) × contactWeight(P, P') × σ(P, Χi) × ι(P',Χk) × ω(Τi,j,k)
-  return pEdge->duration * pEdge->weight * pEdge->pTarget->susceptibility
-         * pEdge->pSource->infectivity * pTransmission->getTransmissibility();
+  return pEdge->duration * pEdge->weight * pEdge->target()->susceptibility
+         * pEdge->source()->infectivity * pTransmission->getTransmissibility();
 }
 
 CTransmission::CTransmission()
@@ -104,8 +104,7 @@ bool CTrigger::processAll()
         }
     }
 
-    CCommunicate::Receive Receive(receive);
-    CCommunicate::roundRobinFixed(pGlobalTriggered, INSTANCES.size() * sizeof(bool), &Receive);
+    CCommunicate::allreduceOr(pGlobalTriggered, INSTANCES.size());
 
     {
       bool * pTriggered = pGlobalTriggered;
@@ -126,24 +125,6 @@ bool CTrigger::processAll()
   return CDependencyGraph::applyUpdateOrder(UpdateSequence);
 }
 
-// static
-CCommunicate::ErrorCode CTrigger::receive(std::istream & is, int /* sender */)
-{
-  bool Received[INSTANCES.size()];
-
-  is.read(reinterpret_cast<char *>(Received), INSTANCES.size() * sizeof(bool));
-
-  bool * pTriggered = pGlobalTriggered;
-  bool * pReceived = Received;
-
-  for (int i = 0; i < (int) INSTANCES.size(); ++i, ++pTriggered, ++pReceived)
-    {
-      *pTriggered |= *pReceived;
-    }
-
-  return CCommunicate::ErrorCode::Success;
-}
-
 CTrigger::CTrigger()
   : CAnnotation()
   , mCondition()
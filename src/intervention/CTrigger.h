@@ -51,8 +51,6 @@ public:
 
   static bool processAll();
 
-  static CCommunicate::ErrorCode receive(std::istream & is, int sender);
-
   CTrigger();
 
   CTrigger(const CTrigger & src);
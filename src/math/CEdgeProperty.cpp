@@ -27,6 +27,7 @@
 
 #include "math/CEdgeProperty.h"
 #include "math/CValue.h"
+#include "network/CNetwork.h"
 #include "network/CEdge.h"
 #include "traits/CTrait.h"
 #include "actions/COperation.h"
@@ -172,13 +173,13 @@ const bool & CEdgeProperty::isValid() const
 // static
 CNode * CEdgeProperty::targetNode(CEdge * pEdge)
 {
-  return pEdge->pTarget;
+  return pEdge->target();
 }
 
 // static
 CNode * CEdgeProperty::sourceNode(CEdge * pEdge)
 {
-  return pEdge->pSource;
+  return pEdge->source();
 }
 
 CValueInterface CEdgeProperty::propertyOf(const CEdge * pEdge) const
@@ -203,11 +204,22 @@ bool CEdgeProperty::isReadOnly() const
 
 CValueInterface CEdgeProperty::targetId(CEdge * pEdge) const
 {
+  // Ids are exposed as PIDs of the original network.
+  CNode * pTarget = pEdge->target();
+
+  if (pTarget != NULL)
+    return CValueInterface(const_cast< size_t & >(CNetwork::OriginalPid(pTarget)));
+
   return CValueInterface(pEdge->targetId);
 }
   
 CValueInterface CEdgeProperty::sourceId(CEdge * pEdge) const
 {
+  CNode * pSource = pEdge->source();
+
+  if (pSource != NULL)
+    return CValueInterface(const_cast< size_t & >(CNetwork::OriginalPid(pSource)));
+
   return CValueInterface(pEdge->sourceId);
 }
 
@@ -27,6 +27,7 @@
 
 #include "math/CNodeProperty.h"
 #include "math/CValue.h"
+#include "network/CNetwork.h"
 #include "network/CNode.h"
 #include "network/CEdge.h"
 #include "diseaseModel/CModel.h"
@@ -166,7 +167,8 @@ std::pair< CEdge *, CEdge * > CNodeProperty::edges(CNode * pNode)
 
 CValueInterface CNodeProperty::id(CNode * pNode) const
 {
-  return CValueInterface(pNode->id);
+  // Ids are exposed as PIDs of the original network.
+  return CValueInterface(const_cast< size_t & >(CNetwork::OriginalPid(pNode)));
 }
 
 CValueInterface CNodeProperty::susceptibilityFactor(CNode * pNode) const
@@ -105,11 +105,10 @@ int CSizeOf::broadcastSize()
 #pragma omp single
   {
     CLogger::setSingle(true);
-    size_t LocalSize = mpSetContent->totalSize();
-    *static_cast< double * >(mpValue) = LocalSize;
+    size_t Size = mpSetContent->totalSize();
 
-    CCommunicate::ClassMemberReceive< CSizeOf > Receive(this, &CSizeOf::receiveSize);
-    CCommunicate::roundRobinFixed(&LocalSize, sizeof(size_t), &Receive);
+    CCommunicate::allreduceSum(&Size, 1);
+    *static_cast< double * >(mpValue) = Size;
     CLogger::setSingle(false);
   }
 
@@ -118,16 +117,6 @@ int CSizeOf::broadcastSize()
   return (int) CCommunicate::ErrorCode::Success;
 }
 
-CCommunicate::ErrorCode CSizeOf::receiveSize(std::istream & is, int /* sender */)
-{
-  size_t RemoteSize;
-
-  is.read(reinterpret_cast< char * >(&RemoteSize), sizeof(size_t));
-  *static_cast< double * >(mpValue) += RemoteSize;
-
-  return CCommunicate::ErrorCode::Success;
-}
-
 void CSizeOf::fromJSON(const json_t * json)
 {
   /*
@@ -72,8 +72,6 @@ private:
 
   int broadcastSize();
 
-  CCommunicate::ErrorCode receiveSize(std::istream & is, int sender);
-
   CSetContent::shared_pointer mpSetContent;
   size_t mIndex;
   std::string mIdentifier;
@@ -22,7 +22,11 @@
 // SOFTWARE 
 // END: Copyright 
 
+#include <cstddef>
+#include <cstring>
+
 #include "network/CEdge.h"
+#include "network/CNetwork.h"
 #include "traits/CTrait.h"
 #include "utilities/CMetadata.h"
 #include "utilities/CLogger.h"
@@ -43,8 +47,6 @@ CEdge CEdge::getDefault()
   Default.edgeTrait = CTrait::EdgeTrait->getDefault();
   Default.active = true;
   Default.weight = 1.0;
-  Default.pTarget = NULL;
-  Default.pSource = NULL;
 
   return Default;
 }
@@ -61,8 +63,6 @@ CEdge::CEdge()
   , edgeTrait()
   , active(true)
   , weight(1.0)
-  , pTarget(NULL)
-  , pSource(NULL)
 {}
 
 CEdge::~CEdge()
@@ -94,6 +94,37 @@ void CEdge::toBinary(std::ostream & os) const
   */
 }
 
+void CEdge::toImage(std::ostream & os) const
+{
+  // Copying the fields into a zeroed buffer keeps the padding deterministic.
+  char Image[sizeof(CEdge)];
+  memset(Image, 0, sizeof(CEdge));
+
+  memcpy(Image + offsetof(CEdge, targetId), &targetId, sizeof(size_t));
+  memcpy(Image + offsetof(CEdge, targetActivity), &targetActivity, sizeof(CTraitData::base));
+  memcpy(Image + offsetof(CEdge, sourceId), &sourceId, sizeof(size_t));
+  memcpy(Image + offsetof(CEdge, sourceActivity), &sourceActivity, sizeof(CTraitData::base));
+  memcpy(Image + offsetof(CEdge, duration), &duration, sizeof(double));
+#ifdef USE_LOCATION_ID
+  memcpy(Image + offsetof(CEdge, locationId), &locationId, sizeof(size_t));
+#endif
+  memcpy(Image + offsetof(CEdge, edgeTrait), &edgeTrait, sizeof(CTraitData::base));
+  memcpy(Image + offsetof(CEdge, active), &active, sizeof(bool));
+  memcpy(Image + offsetof(CEdge, weight), &weight, sizeof(double));
+
+  os.write(Image, sizeof(CEdge));
+}
+
+CNode * CEdge::target() const
+{
+  return CNetwork::EdgeNodes(this).pTarget;
+}
+
+CNode * CEdge::source() const
+{
+  return CNetwork::EdgeNodes(this).pSource;
+}
+
 void CEdge::fromBinary(std::istream & is)
 {
 #ifdef USE_LOCATION_ID
@@ -168,6 +199,7 @@ bool CEdge::setActive(const bool & value, CValueInterface::pOperator ENABLE_TRAC
                               CValueInterface::operatorToString(pOperator),
                               value ? "true" : "false"););
   active = value;
+  CNetwork::MirrorEdge(this);
 
   return true;
 }
@@ -181,6 +213,7 @@ bool CEdge::setWeight(const double & value, CValueInterface::pOperator pOperator
                               CValueInterface::operatorToString(pOperator),
                               value););
   (*pOperator)(weight, value);
+  CNetwork::MirrorEdge(this);
 
   return true;
 }
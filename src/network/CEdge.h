@@ -44,11 +44,31 @@ public:
   static CEdge getDefault();
 
   CEdge();
-  virtual ~CEdge();
+  ~CEdge();
 
   void toBinary(std::ostream & os) const;
   void fromBinary(std::istream & is);
 
+  /**
+   * Write the in-memory image of the edge with the padding zeroed.
+   * The image is used for the edge block of memory mapped partitions and
+   * requires that CEdge has no virtual methods.
+   * @param std::ostream & os
+   */
+  void toImage(std::ostream & os) const;
+
+  /**
+   * Retrieve the target node, which is held by the network since the edge data may be memory mapped
+   * @return CNode * pTarget
+   */
+  CNode * target() const;
+
+  /**
+   * Retrieve the source node, which is held by the network since the edge data may be memory mapped
+   * @return CNode * pSource
+   */
+  CNode * source() const;
+
   bool setTargetActivity(const CTraitData::value & value, CValueInterface::pOperator pOperator, const CMetadata & metadata);
   bool setSourceActivity(const CTraitData::value & value, CValueInterface::pOperator pOperator, const CMetadata & metadata);
   bool setEdgeTrait(const CTraitData::value & value, CValueInterface::pOperator pOperator, const CMetadata & metadata);
@@ -68,9 +88,6 @@ public:
   bool active;
   double weight;
   // end binary data
-
-  CNode * pTarget;
-  CNode * pSource;
 };
 
 #endif /* SRC_NETWORK_CEDGE_H_ */
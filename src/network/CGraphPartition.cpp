@@ -0,0 +1,258 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include <cmath>
+#include <algorithm>
+
+#include "network/CGraphPartition.h"
+#include "utilities/CLogger.h"
+
+// static
+const size_t CGraphPartition::MaxIterations = 20;
+
+CGraphPartition::CGraphPartition(const std::vector< size_t > & inOffsets, const std::vector< size_t > & sources)
+  : mInOffsets(inOffsets)
+  , mSources(sources)
+  , mOffsets()
+  , mAdjacent()
+  , mParts()
+  , mLoads()
+  , mSizes()
+  , mVisited()
+{}
+
+CGraphPartition::~CGraphPartition()
+{}
+
+const std::vector< int > & CGraphPartition::partition(const int & parts, const double & maxImbalance)
+{
+  initAdjacency();
+  initParts(parts);
+  mVisited.assign(mParts.size(), false);
+
+  size_t Capacity = std::ceil((1.0 + maxImbalance) * mSources.size() / parts);
+
+  CLogger::info("CGraphPartition: Initial partition cuts '{}' of '{}' edges.", cutEdges(), mSources.size());
+
+  size_t Nodes = mParts.size();
+
+  for (size_t Iteration = 0; Iteration < MaxIterations; ++Iteration)
+    {
+      size_t Moves = refine(parts, Capacity);
+
+      CLogger::debug("CGraphPartition: Iteration '{}' moved '{}' nodes, cut edges '{}'.", Iteration, Moves, cutEdges());
+
+      // Stop when less than 0.1% of the nodes move.
+      if (1000 * Moves <= Nodes)
+        break;
+    }
+
+  CLogger::info("CGraphPartition: Final partition cuts '{}' of '{}' edges.", cutEdges(), mSources.size());
+
+  return mParts;
+}
+
+void CGraphPartition::reorder(std::vector< size_t > & nodes)
+{
+  if (nodes.empty())
+    return;
+
+  int Part = mParts[nodes.front()];
+
+  // Each component is started from a node of minimal degree.
+  std::vector< size_t > Start(nodes);
+  std::stable_sort(Start.begin(), Start.end(), [this](const size_t & lhs, const size_t & rhs) {
+    return degree(lhs) < degree(rhs);
+  });
+
+  std::vector< size_t > Neighbors;
+
+  nodes.clear();
+
+  for (const size_t & First : Start)
+    {
+      if (mVisited[First])
+        continue;
+
+      mVisited[First] = true;
+      size_t Current = nodes.size();
+      nodes.push_back(First);
+
+      // Breadth first search visiting neighbors in the same part by increasing degree
+      for (; Current < nodes.size(); ++Current)
+        {
+          size_t Node = nodes[Current];
+
+          for (size_t i = mOffsets[Node]; i < mOffsets[Node + 1]; ++i)
+            if (mParts[mAdjacent[i]] == Part
+                && !mVisited[mAdjacent[i]])
+              {
+                mVisited[mAdjacent[i]] = true;
+                Neighbors.push_back(mAdjacent[i]);
+              }
+
+          std::stable_sort(Neighbors.begin(), Neighbors.end(), [this](const size_t & lhs, const size_t & rhs) {
+            return degree(lhs) < degree(rhs);
+          });
+
+          nodes.insert(nodes.end(), Neighbors.begin(), Neighbors.end());
+          Neighbors.clear();
+        }
+    }
+
+  for (const size_t & Node : nodes)
+    mVisited[Node] = false;
+
+  std::reverse(nodes.begin(), nodes.end());
+}
+
+size_t CGraphPartition::degree(const size_t & node) const
+{
+  return mOffsets[node + 1] - mOffsets[node];
+}
+
+size_t CGraphPartition::cutEdges() const
+{
+  size_t Cut = 0;
+  size_t Nodes = mInOffsets.size() - 1;
+
+  for (size_t Target = 0; Target < Nodes; ++Target)
+    for (size_t Edge = mInOffsets[Target]; Edge < mInOffsets[Target + 1]; ++Edge)
+      if (mParts[Target] != mParts[mSources[Edge]])
+        ++Cut;
+
+  return Cut;
+}
+
+void CGraphPartition::initAdjacency()
+{
+  size_t Nodes = mInOffsets.size() - 1;
+
+  // mOffsets[i + 1] is the degree of node i.
+  mOffsets.assign(Nodes + 1, 0);
+
+  for (size_t Target = 0; Target < Nodes; ++Target)
+    for (size_t Edge = mInOffsets[Target]; Edge < mInOffsets[Target + 1]; ++Edge)
+      if (mSources[Edge] != Target)
+        {
+          ++mOffsets[Target + 1];
+          ++mOffsets[mSources[Edge] + 1];
+        }
+
+  for (size_t i = 1; i <= Nodes; ++i)
+    mOffsets[i] += mOffsets[i - 1];
+
+  mAdjacent.resize(mOffsets[Nodes]);
+  std::vector< size_t > Cursor(mOffsets.begin(), mOffsets.end() - 1);
+
+  for (size_t Target = 0; Target < Nodes; ++Target)
+    for (size_t Edge = mInOffsets[Target]; Edge < mInOffsets[Target + 1]; ++Edge)
+      if (mSources[Edge] != Target)
+        {
+          mAdjacent[Cursor[Target]++] = mSources[Edge];
+          mAdjacent[Cursor[mSources[Edge]]++] = Target;
+        }
+}
+
+void CGraphPartition::initParts(const int & parts)
+{
+  size_t Nodes = mInOffsets.size() - 1;
+  size_t Total = mSources.size();
+
+  mParts.resize(Nodes);
+  mLoads.assign(parts, 0);
+  mSizes.assign(parts, 0);
+
+  size_t Previous = 0;
+
+  // Contiguous index ranges balanced by edge count, which is the partition created by CNetwork::partition
+  for (size_t Node = 0; Node < Nodes; ++Node)
+    {
+      size_t Weight = mInOffsets[Node + 1] - mInOffsets[Node];
+      size_t Part = Total > 0 ? ((mInOffsets[Node] + Weight / 2) * parts) / Total : (Node * parts) / Nodes;
+
+      // Nodes with a large in degree must not skip a part and the remaining nodes must suffice
+      // to fill the remaining parts.
+      if (Node == 0)
+        Part = 0;
+      else if (Part > Previous + 1)
+        Part = Previous + 1;
+
+      if (Part + Nodes - Node < (size_t) parts)
+        Part = parts - (Nodes - Node);
+
+      if (Part >= (size_t) parts)
+        Part = parts - 1;
+
+      mParts[Node] = Part;
+      mLoads[Part] += Weight;
+      ++mSizes[Part];
+      Previous = Part;
+    }
+}
+
+size_t CGraphPartition::refine(const int & parts, const size_t & capacity)
+{
+  size_t Nodes = mInOffsets.size() - 1;
+  size_t Moves = 0;
+
+  std::vector< size_t > Contacts(parts, 0);
+  std::vector< int > Touched;
+
+  for (size_t Node = 0; Node < Nodes; ++Node)
+    {
+      int Current = mParts[Node];
+      size_t Weight = mInOffsets[Node + 1] - mInOffsets[Node];
+
+      for (size_t i = mOffsets[Node]; i < mOffsets[Node + 1]; ++i)
+        if (Contacts[mParts[mAdjacent[i]]]++ == 0)
+          Touched.push_back(mParts[mAdjacent[i]]);
+
+      int Best = Current;
+
+      // The last node of a part never moves.
+      if (mSizes[Current] > 1)
+        for (int Part : Touched)
+          if (Contacts[Part] > Contacts[Best]
+              && mLoads[Part] + Weight <= capacity)
+            Best = Part;
+
+      for (int Part : Touched)
+        Contacts[Part] = 0;
+
+      Touched.clear();
+
+      if (Best != Current)
+        {
+          mLoads[Current] -= Weight;
+          mLoads[Best] += Weight;
+          --mSizes[Current];
+          ++mSizes[Best];
+          mParts[Node] = Best;
+          ++Moves;
+        }
+    }
+
+  return Moves;
+}
@@ -0,0 +1,98 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_NETWORK_CGRAPHPARTITION_H_
+#define SRC_NETWORK_CGRAPHPARTITION_H_
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * A partition of the contact graph into parts of balanced edge count which minimizes
+ * the number of edges between parts.
+ *
+ * The nodes are identified by their index. The graph is given by the incoming edges of
+ * each node, which are stored with the target's partition, i.e., the weight of a node is
+ * its in degree. Starting from a partition into contiguous index ranges the partition
+ * is refined by label propagation, where a node moves to the part it has most contacts
+ * with as long as that part does not exceed its capacity. Every part keeps at least one
+ * node, which requires that there are at least as many nodes as parts.
+ */
+class CGraphPartition
+{
+public:
+  /**
+   * Constructor
+   * @param const std::vector< size_t > & inOffsets the incoming edges of node i are [inOffsets[i], inOffsets[i + 1])
+   * @param const std::vector< size_t > & sources the source index of each edge
+   */
+  CGraphPartition(const std::vector< size_t > & inOffsets, const std::vector< size_t > & sources);
+
+  ~CGraphPartition();
+
+  /**
+   * Compute the partition
+   * @param const int & parts
+   * @param const double & maxImbalance the relative amount a part may exceed the average edge count
+   * @return const std::vector< int > & the part of each node
+   */
+  const std::vector< int > & partition(const int & parts, const double & maxImbalance);
+
+  /**
+   * Retrieve the number of edges whose target and source are in different parts
+   * @return size_t cutEdges
+   */
+  size_t cutEdges() const;
+
+  /**
+   * Reorder the nodes of a part by reverse Cuthill-McKee, which places contacts close to each other.
+   * The partition must have been computed.
+   * @param std::vector< size_t > & nodes the nodes of a single part
+   */
+  void reorder(std::vector< size_t > & nodes);
+
+private:
+  static const size_t MaxIterations;
+
+  void initAdjacency();
+  void initParts(const int & parts);
+  size_t refine(const int & parts, const size_t & capacity);
+  size_t degree(const size_t & node) const;
+
+  const std::vector< size_t > & mInOffsets;
+  const std::vector< size_t > & mSources;
+
+  // The undirected contact graph in compressed sparse row format
+  std::vector< size_t > mOffsets;
+  std::vector< size_t > mAdjacent;
+
+  std::vector< int > mParts;
+  std::vector< size_t > mLoads;
+  std::vector< size_t > mSizes;
+
+  // Allocated once by partition(); reorder() resets the entries of the nodes it visited.
+  std::vector< bool > mVisited;
+};
+
+#endif /* SRC_NETWORK_CGRAPHPARTITION_H_ */
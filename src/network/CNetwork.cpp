@@ -23,14 +23,21 @@
 // END: Copyright 
 
 #include <algorithm>
+#include <iterator>
 #include <cmath>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <vector>
+#include <memory>
 #include <cstdio>
 #include <cstring>
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <jansson.h>
 
 #include "actions/CActionQueue.h"
@@ -40,18 +47,31 @@
 #include "actions/CChanges.h"
 #include "network/CEdge.h"
 #include "network/CNetwork.h"
+#include "network/CGraphPartition.h"
 
 #include "utilities/CSimConfig.h"
+#include "utilities/CAsyncWriter.h"
 #include "utilities/CDirEntry.h"
+#include "utilities/CCheckpoint.h"
 #include "network/CNode.h"
 
+// The size of the stream buffer used when reading networks.
+const size_t CNetwork::NetworkBufferSize = 1 << 22;
+
+// The number of nodes tracked by each word of the frontier bitmap.
+static const size_t FrontierWordBits = 8 * sizeof(size_t);
+
 // static
 void CNetwork::init()
 {
   CChanges::init();
   Context.init();
 
-  Context.Master().loadJsonPreamble(CSimConfig::getContactNetwork());
+  if (CCheckpoint::isRestart())
+    Context.Master().loadJsonPreamble(CCheckpoint::getNetwork());
+  else
+    Context.Master().loadJsonPreamble(CSimConfig::getContactNetwork());
+
   Context.Master().partition(CCommunicate::TotalProcesses(), false);
 }
 
@@ -96,6 +116,13 @@ int CNetwork::index(const CNode * pNode)
 // static 
 int CNetwork::index(const size_t & id)
 {
+  if (Context.Master().mNodeIndex.isValid())
+    {
+      CNode * pNode = Context.Master().lookupNode(id, true);
+
+      return pNode != NULL ? index(pNode) : -1;
+    }
+
   if (Context.Master().isRemoteNode(id))
     return -1;
 
@@ -140,9 +167,15 @@ CNetwork::CNetwork()
   , mExternalNodes(NULL)
   , mExternalNodesSize(0)
   , mRemoteNodes()
+  , mNodeIndex()
   , mSourceOnlyNodes()
   , mEdges(NULL)
   , mEdgesSize(0)
+  , mEdgesBySource()
+  , mOutgoingEdges()
+  , mEdgeOffset(0)
+  , mpEdgeMap(NULL)
+  , mEdgeMapSize(0)
   , mTotalNodesSize(0)
   , mTotalEdgesSize(0)
   , mSizeOfPid(0)
@@ -152,6 +185,19 @@ CNetwork::CNetwork()
   , mValid(false)
   , mpJson(NULL)
   , mDumpActiveNetwork()
+  , mLine()
+  , mKey()
+  , mActivityCache()
+  , mEdgeTraitCache()
+  , mpNodeMirror(NULL)
+  , mEdgeMirror({NULL, NULL, NULL, NULL})
+  , mFrontierBits()
+  , mFrontier()
+  , mHaveFrontier(false)
+  , mOriginalPids()
+  , mNodesByOriginalPid()
+  , mOriginalPidReplies()
+  , mHaveOriginalPids(false)
 {}
 
 void CNetwork::loadJsonPreamble(const std::string & networkFile)
@@ -172,6 +218,24 @@ void CNetwork::loadJsonPreamble(const std::string & networkFile)
 // virtual
 CNetwork::~CNetwork()
 {
+  // The edge mirror is owned by the thread.
+  if (mEdgeMirror.pActive != NULL)
+    {
+      delete[] mEdgeMirror.pActive;
+      delete[] mEdgeMirror.pWeight;
+      delete[] mEdgeMirror.pDuration;
+      delete[] mEdgeMirror.pSource;
+      mEdgeMirror = {NULL, NULL, NULL, NULL};
+    }
+
+  // Memory mapped edges are owned by the thread which mapped them.
+  if (mpEdgeMap != NULL)
+    {
+      munmap(mpEdgeMap, mEdgeMapSize);
+      mpEdgeMap = NULL;
+      mEdges = NULL;
+    }
+
   if (!Context.isMaster(this))
     return;
 
@@ -198,6 +262,12 @@ CNetwork::~CNetwork()
       delete [] mExternalNodes;
       mExternalNodes = NULL;
     }
+
+  if (mpNodeMirror != NULL)
+    {
+      delete [] mpNodeMirror;
+      mpNodeMirror = NULL;
+    }
 }
 
 void CNetwork::fromJSON(const json_t * json)
@@ -333,6 +403,26 @@ void CNetwork::fromJSON(const json_t * json)
         "beyondLocalNode": {
           "description": "The number of the first node beyond the local nodes",
           "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
+        },
+        "version": {
+          "description": "The version of the partition format. Version 2 stores the edges as a page aligned block of in-memory images (Default: 1).",
+          "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
+        },
+        "sizeofEdge": {
+          "description": "The size of an edge image in bytes (version 2 only)",
+          "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
+        },
+        "edgeOffset": {
+          "description": "The file offset of the edge block in bytes (version 2 only)",
+          "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
+        },
+        "numberOfOriginalPIDs": {
+          "description": "The number of PIDs in the original network of the local nodes (relabeled partitions only)",
+          "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
+        },
+        "originalPIDOffset": {
+          "description": "The file offset in bytes of the binary block of original PIDs of the local nodes in the order of their ids (relabeled partitions only)",
+          "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
         }
       }
     },
@@ -341,6 +431,10 @@ void CNetwork::fromJSON(const json_t * json)
       "items": {
         "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
       }
+    },
+    "pidMap": {
+      "description": "The file mapping the relabeled PIDs of a minimum cut partition to the original PIDs",
+      "type": "string"
     }
   }
 }
@@ -547,7 +641,12 @@ void CNetwork::partition(const int & parts, const bool & save, const std::string
       return; 
     }
 
-  std::ifstream is(mFile.c_str());
+  // Networks are read in large blocks.
+  std::vector< char > Buffer(NetworkBufferSize);
+  std::ifstream is;
+  is.rdbuf()->pubsetbuf(Buffer.data(), Buffer.size());
+  is.open(mFile.c_str());
+
   std::string Line;
   // Skip JSON Header
   std::getline(is, Line);
@@ -636,13 +735,280 @@ void CNetwork::convert(std::istream & is, const std::string & outputDirectory)
 
       while (is.good() && loadEdge(&Edge, is))
         {
-          Edge.toBinary(os);
+          Edge.toImage(os);
         }
 
       os.close();
     }
 }
 
+void CNetwork::partitionMinimumCut(const int & parts, const double & maxImbalance, const bool & reorder, const std::string & outputDirectory)
+{
+  if (!mValid)
+    {
+      return;
+    }
+
+  // Relabeling only pays off when there are edges between parts or nodes are reordered.
+  if (parts < 1
+      || (parts == 1 && !reorder))
+    {
+      partition(parts, true, outputDirectory);
+      return;
+    }
+
+  if (CCommunicate::MPIRank != 0)
+    return;
+
+  // Networks are read in large blocks.
+  std::vector< char > Buffer(NetworkBufferSize);
+  std::ifstream is;
+  is.rdbuf()->pubsetbuf(Buffer.data(), Buffer.size());
+  is.open(mFile.c_str());
+
+  std::string Line;
+  // Skip JSON Header
+  std::getline(is, Line);
+  // Skip Column Header
+  std::getline(is, Line);
+
+  // Read the contact graph, the edges are sorted by target.
+  std::vector< size_t > Targets;
+  std::vector< size_t > InDegrees;
+  std::vector< size_t > Sources;
+
+  CEdge Edge = CEdge::getDefault();
+
+  while (is.good() && loadEdge(&Edge, is))
+    {
+      if (Targets.empty()
+          || Targets.back() != Edge.targetId)
+        {
+          if (!Targets.empty()
+              && Targets.back() > Edge.targetId)
+            {
+              CLogger::error("Network target nodes are not sorted.");
+              return;
+            }
+
+          Targets.push_back(Edge.targetId);
+          InDegrees.push_back(0);
+        }
+
+      ++InDegrees.back();
+      Sources.push_back(Edge.sourceId);
+    }
+
+  // All nodes sorted by id
+  std::vector< size_t > Ids;
+  Ids.reserve(Targets.size() + mSourceOnlyNodes.size());
+  std::merge(Targets.begin(), Targets.end(), mSourceOnlyNodes.begin(), mSourceOnlyNodes.end(), std::back_inserter(Ids));
+  Ids.erase(std::unique(Ids.begin(), Ids.end()), Ids.end());
+
+  size_t Nodes = Ids.size();
+
+  if (Nodes == 0)
+    {
+      CLogger::error("Network file: '{}' does not contain any nodes.", mFile);
+      return;
+    }
+
+  if (Nodes < (size_t) parts)
+    {
+      CLogger::error("Network file: '{}' contains fewer nodes '{}' than requested parts '{}'.", mFile, Nodes, parts);
+      return;
+    }
+
+  std::vector< size_t > InOffsets(Nodes + 1, 0);
+  size_t Target = 0;
+
+  for (size_t i = 0; i < Nodes; ++i)
+    {
+      InOffsets[i + 1] = InOffsets[i];
+
+      if (Target < Targets.size()
+          && Targets[Target] == Ids[i])
+        InOffsets[i + 1] += InDegrees[Target++];
+    }
+
+  std::vector< size_t >().swap(Targets);
+  std::vector< size_t >().swap(InDegrees);
+
+  for (size_t & Source : Sources)
+    {
+      std::vector< size_t >::const_iterator found = std::lower_bound(Ids.begin(), Ids.end(), Source);
+
+      if (found == Ids.end()
+          || *found != Source)
+        {
+          CLogger::error("Network file: '{}' Source not found {}.", mFile, Source);
+          return;
+        }
+
+      Source = found - Ids.begin();
+    }
+
+  CGraphPartition Graph(InOffsets, Sources);
+  const std::vector< int > & Parts = Graph.partition(parts, maxImbalance);
+
+  // The nodes of part p are relabeled to the ids [Ids[PartBegin[p]], Ids[PartBegin[p + 1]]),
+  // i.e., the set of ids is preserved and nodes within a part keep their order unless they are reordered.
+  std::vector< size_t > PartBegin(parts + 1, 0);
+  std::vector< size_t > PartEdges(parts, 0);
+
+  for (size_t i = 0; i < Nodes; ++i)
+    {
+      ++PartBegin[Parts[i] + 1];
+      PartEdges[Parts[i]] += InOffsets[i + 1] - InOffsets[i];
+    }
+
+  for (int p = 1; p <= parts; ++p)
+    PartBegin[p] += PartBegin[p - 1];
+
+  // Order[r] is the node relabeled to Ids[r].
+  std::vector< size_t > Order(Nodes);
+  std::vector< size_t > Cursor(PartBegin.begin(), PartBegin.end() - 1);
+
+  for (size_t i = 0; i < Nodes; ++i)
+    Order[Cursor[Parts[i]]++] = i;
+
+  if (reorder)
+    for (int p = 0; p < parts; ++p)
+      {
+        std::vector< size_t > PartNodes(Order.begin() + PartBegin[p], Order.begin() + PartBegin[p + 1]);
+        Graph.reorder(PartNodes);
+        std::copy(PartNodes.begin(), PartNodes.end(), Order.begin() + PartBegin[p]);
+      }
+
+  std::vector< size_t > NewIds(Nodes);
+
+  for (size_t r = 0; r < Nodes; ++r)
+    NewIds[Order[r]] = Ids[r];
+
+  std::string FileName = mFile;
+
+  if (!outputDirectory.empty())
+    {
+      FileName = CDirEntry::fileName(mFile);
+      CDirEntry::makePathAbsolute(FileName, outputDirectory);
+    }
+
+  std::string PidMap = FileName + ".pidmap";
+  std::ofstream Map(PidMap.c_str());
+
+  if (Map.fail())
+    {
+      CLogger::error("Network: Failed to write PID map '{}'.", PidMap);
+      return;
+    }
+
+  Map << "originalPID,PID\n";
+
+  for (size_t i = 0; i < Nodes; ++i)
+    Map << Ids[i] << "," << NewIds[i] << "\n";
+
+  Map.close();
+
+  // The preamble of the parts refers to the relabeled ids.
+  std::set< size_t > SourceOnlyNodes;
+
+  for (const size_t & Id : mSourceOnlyNodes)
+    SourceOnlyNodes.insert(NewIds[std::lower_bound(Ids.begin(), Ids.end(), Id) - Ids.begin()]);
+
+  mSourceOnlyNodes.swap(SourceOnlyNodes);
+
+  if (json_object_get(mpJson, "sourceOnlyNodes") != NULL)
+    {
+      json_t * pSourceOnlyNodes = json_array();
+
+      for (const size_t & Id : mSourceOnlyNodes)
+        json_array_append_new(pSourceOnlyNodes, json_integer(Id));
+
+      json_object_set_new(mpJson, "sourceOnlyNodes", pSourceOnlyNodes);
+    }
+
+  json_object_set_new(mpJson, "pidMap", json_string(CDirEntry::fileName(PidMap).c_str()));
+
+  std::vector< std::ofstream > Streams(parts);
+
+  for (int p = 0; p < parts; ++p)
+    {
+      size_t FirstLocalNode = PartBegin[p] < Nodes ? Ids[PartBegin[p]] : Ids.back() + 1;
+      size_t BeyondLocalNode = PartBegin[p + 1] < Nodes ? Ids[PartBegin[p + 1]] : Ids.back() + 1;
+
+      // The original PIDs of the local nodes in the order of their ids
+      std::vector< size_t > OriginalPids;
+      OriginalPids.reserve(PartBegin[p + 1] - PartBegin[p]);
+
+      for (size_t r = PartBegin[p]; r < PartBegin[p + 1]; ++r)
+        OriginalPids.push_back(Ids[Order[r]]);
+
+      if (!openPartition(p + 1, parts, PartBegin[p + 1] - PartBegin[p], FirstLocalNode, BeyondLocalNode, PartEdges[p], outputDirectory, Streams[p], &OriginalPids))
+        {
+          CLogger::error("Network: Failed to write partition '{}'.", p);
+          return;
+        }
+    }
+
+  // Reordered edges are no longer sorted by target. Instead of holding them in memory each node's
+  // incoming edges, which are contiguous in the network file, are written at their position in the part.
+  std::vector< std::streampos > EdgeBegin(parts);
+  std::vector< size_t > Position;
+
+  if (reorder)
+    {
+      Position.resize(Nodes);
+
+      for (int p = 0; p < parts; ++p)
+        {
+          EdgeBegin[p] = Streams[p].tellp();
+          size_t Current = 0;
+
+          for (size_t r = PartBegin[p]; r < PartBegin[p + 1]; ++r)
+            {
+              Position[Order[r]] = Current;
+              Current += InOffsets[Order[r] + 1] - InOffsets[Order[r]];
+            }
+        }
+    }
+
+  is.clear();                 // clear fail and eof bits
+  is.seekg(0, std::ios::beg); // back to the start!
+
+  // Skip JSON Header
+  std::getline(is, Line);
+  // Skip Column Header
+  std::getline(is, Line);
+
+  // Without reordering the edges of a part are still sorted by target since the relabeling preserves
+  // the order within a part.
+  size_t EdgeIndex = 0;
+  size_t Node = 0;
+
+  while (is.good() && loadEdge(&Edge, is))
+    {
+      while (InOffsets[Node + 1] <= EdgeIndex)
+        ++Node;
+
+      if (reorder
+          && EdgeIndex == InOffsets[Node])
+        Streams[Parts[Node]].seekp(EdgeBegin[Parts[Node]] + (std::streamoff) (Position[Node] * sizeof(CEdge)));
+
+      Edge.targetId = NewIds[Node];
+      Edge.sourceId = NewIds[Sources[EdgeIndex]];
+      Edge.toImage(Streams[Parts[Node]]);
+
+      ++EdgeIndex;
+    }
+
+  for (std::ofstream & os : Streams)
+    os.close();
+
+  is.close();
+
+  CLogger::info("Network: Wrote '{}' parts with '{}' cut edges and PID map '{}'.", parts, Graph.cutEdges(), PidMap);
+}
+
 void CNetwork::partition(std::istream & is, const int & parts, const bool & save, const std::string & outputDirectory)
 {
   // Communicate::Processes = 8;
@@ -766,7 +1132,8 @@ void CNetwork::partition(std::istream & is, const int & parts, const bool & save
               CurrentNode = Node;
             }
 
-          Edge.toBinary(NodeBuffer);
+          if (save)
+            Edge.toImage(NodeBuffer);
 
           ++*pEdges;
 
@@ -839,7 +1206,13 @@ void CNetwork::load()
 
   CNetwork * pEnd = Context.endThread();
 
-#pragma omp parallel
+  // Edges of memory mapped partitions do not need to be allocated.
+  size_t AllocatedEdgesSize = 0;
+
+  // Relabeled partitions carry the relabeled source only nodes.
+  bool RelabeledSourceOnlyNodes = false;
+
+#pragma omp parallel reduction(+: AllocatedEdgesSize)
   {
     CNetwork & Active = Context.Active();
 
@@ -898,6 +1271,32 @@ void CNetwork::load()
             Active.mValid = false;
           }
 
+        pValue = json_object_get(pPartition, "version");
+
+        if (json_is_integer(pValue)
+            && json_integer_value(pValue) >= 2)
+          {
+            pValue = json_object_get(pPartition, "sizeofEdge");
+
+            if (!json_is_integer(pValue)
+                || (size_t) json_integer_value(pValue) != sizeof(CEdge))
+              {
+                CLogger::error("Network file: '{}' edge size mismatch, the network must be partitioned again.", Active.mFile);
+                Active.mValid = false;
+              }
+
+            pValue = json_object_get(pPartition, "edgeOffset");
+
+            if (json_is_integer(pValue))
+              {
+                Active.mEdgeOffset = json_integer_value(pValue);
+              }
+            else
+              {
+                Active.mValid = false;
+              }
+          }
+
         pValue = json_object_get(pJson, "encoding");
 
         if (json_is_string(pValue))
@@ -910,13 +1309,67 @@ void CNetwork::load()
             Active.mValid = false;
           }
 
+        if (json_is_string(json_object_get(pJson, "pidMap")))
+#pragma omp critical (load_network_master_data)
+          {
+            if (!RelabeledSourceOnlyNodes)
+              {
+                mSourceOnlyNodes.clear();
+                pValue = json_object_get(pJson, "sourceOnlyNodes");
+
+                for (size_t i = 0, imax = json_array_size(pValue); i < imax; ++i)
+                  mSourceOnlyNodes.insert(json_integer_value(json_array_get(pValue, i)));
+
+                RelabeledSourceOnlyNodes = true;
+              }
+          }
+
+        pValue = json_object_get(pPartition, "numberOfOriginalPIDs");
+
+        if (json_is_integer(pValue))
+          {
+            json_t * pOffset = json_object_get(pPartition, "originalPIDOffset");
+
+            if ((size_t) json_integer_value(pValue) == Active.mLocalNodesSize
+                && json_is_integer(pOffset))
+              {
+                Active.mOriginalPids.resize(Active.mLocalNodesSize);
+
+                std::ifstream is(Active.mFile.c_str(), std::ios_base::binary);
+                is.seekg(json_integer_value(pOffset));
+                is.read(reinterpret_cast< char * >(Active.mOriginalPids.data()), Active.mLocalNodesSize * sizeof(size_t));
+
+                if (is.fail())
+                  {
+                    CLogger::error("Network file: '{}' failed to read original PIDs.", Active.mFile);
+                    Active.mValid = false;
+                  }
+              }
+            else
+              {
+                CLogger::error("Network file: '{}' invalid 'numberOfOriginalPIDs'.", Active.mFile);
+                Active.mValid = false;
+              }
+          }
+
         json_decref(pJson);
+
+        // The edge block is mapped if it is aligned with the page size, otherwise it is read.
+        if (Active.mValid
+            && Active.mEdgeOffset > 0
+            && Active.mEdgesSize > 0
+            && Active.mEdgeOffset % sysconf(_SC_PAGESIZE) == 0
+            && !Active.mapEdges())
+          CLogger::warn("Network file: '{}' memory mapping failed, reading edges.", Active.mFile);
       }
     else
       {
         Active.mFile = mFile;
       }
 
+    if (Active.mpEdgeMap == NULL)
+      AllocatedEdgesSize += Active.mEdgesSize;
+
     if (Context.isThread(&Active))
 #pragma omp critical (load_network_master_data)
       {
@@ -942,20 +1395,26 @@ void CNetwork::load()
       return;
     }
 
-  CLogger::info("Network: Allocating edges '{}' ({} bytes).", mEdgesSize, mEdgesSize * sizeof(CEdge));
-
-  try
+  if (AllocatedEdgesSize > 0)
     {
-      mEdges = new CEdge[mEdgesSize];
-    }
+      CLogger::info("Network: Allocating edges '{}' ({} bytes).", AllocatedEdgesSize, AllocatedEdgesSize * sizeof(CEdge));
 
-  catch (...)
-    {
-      CLogger::error("Network: Allocating edges failed '{}' ({} bytes).", mEdgesSize, mEdgesSize * sizeof(CEdge));
+      try
+        {
+          mEdges = new CEdge[AllocatedEdgesSize];
+        }
 
-      return;
+      catch (...)
+        {
+          CLogger::error("Network: Allocating edges failed '{}' ({} bytes).", AllocatedEdgesSize, AllocatedEdgesSize * sizeof(CEdge));
+
+          return;
+        }
     }
 
+  if (AllocatedEdgesSize < mEdgesSize)
+    CLogger::info("Network: Mapped edges '{}' ({} bytes).", mEdgesSize - AllocatedEdgesSize, (mEdgesSize - AllocatedEdgesSize) * sizeof(CEdge));
+
   CLogger::info("Network: Allocation completed");
   CNode * pNode = mLocalNodes;
   CEdge * pEdge = mEdges;
@@ -965,8 +1424,12 @@ void CNetwork::load()
       {
         pIt->mLocalNodes = pNode;
         pNode += pIt->mLocalNodesSize;
-        pIt->mEdges = pEdge;
-        pEdge += pIt->mEdgesSize;
+
+        if (pIt->mpEdgeMap == NULL)
+          {
+            pIt->mEdges = pEdge;
+            pEdge += pIt->mEdgesSize;
+          }
         pIt->mTotalNodesSize = mTotalNodesSize;
         pIt->mTotalEdgesSize = mTotalEdgesSize;
         pIt->mSizeOfPid = mSizeOfPid;
@@ -981,8 +1444,11 @@ void CNetwork::load()
   {
     CNetwork & Active = Context.Active();
     std::ostringstream File;
+    std::vector< char > Buffer(NetworkBufferSize);
     std::ifstream is;
 
+    // Each thread reads its part of the network in large blocks.
+    is.rdbuf()->pubsetbuf(Buffer.data(), Buffer.size());
     is.open(Active.mFile.c_str());
 
     if (is.fail())
@@ -998,6 +1464,11 @@ void CNetwork::load()
     // Skip Column Header
     std::getline(is, Line);
 
+    // Skip the padding in front of an edge block which is read.
+    if (Active.mEdgeOffset > 0
+        && Active.mpEdgeMap == NULL)
+      is.seekg(Active.mEdgeOffset);
+
     std::set< size_t >::const_iterator itSourceOnlyNode;
 
     if (Context.globalIndex(&Active) == 0)
@@ -1022,18 +1493,35 @@ void CNetwork::load()
     CEdge * pEdgeEnd = pEdge + Active.mEdgesSize;
     CEdge DefaultEdge = CEdge::getDefault();
 
+    // The nodes of the edges are kept separately so that mapped edges are not written to.
+    Active.mEdgeNodes.assign(Active.mEdgesSize, sEdgeNodes({NULL, NULL}));
+
     bool FirstTime = true;
 
-    while (is.good() && pNode < pNodeEnd && pEdge < pEdgeEnd)
+    while ((Active.mpEdgeMap != NULL || is.good()) && pNode < pNodeEnd && pEdge < pEdgeEnd)
       {
-        *pEdge = DefaultEdge;
+        if (Active.mpEdgeMap != NULL)
+          {
+            // Mapped edges are already in place only their nodes need to be determined.
+            if (pEdge->targetId < Active.mFirstLocalNode || Active.mBeyondLocalNode <= pEdge->targetId)
+              {
+                CLogger::error("Network file: '{}' invalid edge ({}).", Active.mFile, pEdge - Active.beginEdge());
 
-        if (!Active.loadEdge(pEdge, is))
+                Active.mValid = false; // DONE
+                break;
+              }
+          }
+        else
           {
-            CLogger::error("Network file: '{}' invalid edge ({}).", mFile, pEdge - Active.beginEdge());
+            *pEdge = DefaultEdge;
+
+            if (!Active.loadEdge(pEdge, is))
+              {
+                CLogger::error("Network file: '{}' invalid edge ({}).", mFile, pEdge - Active.beginEdge());
 
-            Active.mValid = false; // DONE
-            break;
+                Active.mValid = false; // DONE
+                break;
+              }
           }
 
         if (pEdge->targetId < Active.mFirstLocalNode)
@@ -1089,16 +1577,20 @@ void CNetwork::load()
               }
           }
 
-        pEdge->pTarget = pNode;
+        Active.mEdgeNodes[pEdge - Active.mEdges].pTarget = pNode;
 
         if (pEdge->sourceId < Active.mFirstLocalNode || Active.mBeyondLocalNode <= pEdge->sourceId)
           {
-            Active.mRemoteNodes[pEdge->sourceId] = NULL;
+            if (Active.mRemoteNodes.empty()
+                || Active.mRemoteNodes.back().first != pEdge->sourceId)
+              Active.mRemoteNodes.push_back(std::make_pair(pEdge->sourceId, (CNode *) NULL));
 
-            if (CCommunicate::LocalProcesses() > 1)
-              if (pEdge->sourceId < mFirstLocalNode || mBeyondLocalNode <= pEdge->sourceId)
-#pragma omp critical (load_network_master_remote_nodes)
-                mRemoteNodes[pEdge->sourceId] = NULL;
+            // Limit the memory used by duplicates
+            if (Active.mRemoteNodes.size() == Active.mRemoteNodes.capacity())
+              {
+                CompactRemoteNodes(Active.mRemoteNodes);
+                Active.mRemoteNodes.reserve(2 * Active.mRemoteNodes.size() + 1);
+              }
           }
 
         ++pEdge;
@@ -1126,6 +1618,8 @@ void CNetwork::load()
                || pNode->id == std::numeric_limits< size_t >::max());
       }
 
+    CompactRemoteNodes(Active.mRemoteNodes);
+
 #pragma omp atomic
     mValid &= Active.mValid;
     is.close();
@@ -1135,35 +1629,59 @@ void CNetwork::load()
     return;
 
   initExternalEdges();
+  initNodeIndex();
+  initEdgeIndex();
   initOutgoingEdges();
+  initMirror();
+  initFrontier();
+  initOriginalPids();
+}
+
+// static
+void CNetwork::CompactRemoteNodes(std::vector< std::pair< size_t, CNode * > > & remoteNodes)
+{
+  std::sort(remoteNodes.begin(), remoteNodes.end());
+  remoteNodes.erase(std::unique(remoteNodes.begin(), remoteNodes.end()), remoteNodes.end());
 }
 
 void CNetwork::initExternalEdges()
 {
   CNode DefaultNode = CNode::getDefault();
 
+  // The remote nodes of the master are the remote nodes of the threads which are not local to the master.
+  if (CCommunicate::LocalProcesses() > 1)
+    {
+      mRemoteNodes.clear();
+
+      CNetwork * pThread = Context.beginThread();
+      CNetwork * pThreadEnd = Context.endThread();
+
+      for (; pThread != pThreadEnd; ++pThread)
+        if (Context.isThread(pThread))
+          {
+            std::vector< std::pair< size_t, CNode * > >::const_iterator it = pThread->mRemoteNodes.begin();
+            std::vector< std::pair< size_t, CNode * > >::const_iterator end = pThread->mRemoteNodes.end();
+
+            for (; it != end; ++it)
+              if (it->first < mFirstLocalNode || mBeyondLocalNode <= it->first)
+                mRemoteNodes.push_back(*it);
+          }
+
+      CompactRemoteNodes(mRemoteNodes);
+    }
+
   mExternalNodesSize = mRemoteNodes.size();
 
   if (mExternalNodesSize > 0)
     mExternalNodes = new CNode[mExternalNodesSize];
 
-#pragma omp parallel
-  {
-#pragma omp single
+#pragma omp parallel for
+  for (size_t i = 0; i < mExternalNodesSize; ++i)
     {
-      CNode * pExternalNode = mExternalNodes;
-      std::map< size_t, CNode * >::iterator it = mRemoteNodes.begin();
-      std::map< size_t, CNode * >::iterator end = mRemoteNodes.end();
-
-      for (; it != end; ++it, ++pExternalNode)
-#pragma omp task
-        {
-          *pExternalNode = DefaultNode;
-          pExternalNode->id = it->first;
-          it->second = pExternalNode;
-        }
+      mExternalNodes[i] = DefaultNode;
+      mExternalNodes[i].id = mRemoteNodes[i].first;
+      mRemoteNodes[i].second = mExternalNodes + i;
     }
-  }
 
   // If we are running single threaded the above code took care of this,
   // since mRemoteNodes and Context.Active().mRemoteNodes are identical.
@@ -1172,8 +1690,8 @@ void CNetwork::initExternalEdges()
     {
       CNetwork & Active = Context.Active();
 
-      std::map< size_t, CNode * >::iterator it = Active.mRemoteNodes.begin();
-      std::map< size_t, CNode * >::iterator end = Active.mRemoteNodes.end();
+      std::vector< std::pair< size_t, CNode * > >::iterator it = Active.mRemoteNodes.begin();
+      std::vector< std::pair< size_t, CNode * > >::iterator end = Active.mRemoteNodes.end();
 
       for (; it != end; ++it)
         {
@@ -1182,51 +1700,567 @@ void CNetwork::initExternalEdges()
     }
 }
 
-void CNetwork::initOutgoingEdges()
+void CNetwork::initOriginalPids()
+{
+  bool HaveOriginalPids = false;
+
+  CNetwork * pThread = Context.beginThread();
+  CNetwork * pThreadEnd = Context.endThread();
+
+  for (; pThread != pThreadEnd; ++pThread)
+    HaveOriginalPids |= !pThread->mOriginalPids.empty();
+
+  // The exchange below is collective, i.e., all ranks must agree.
+  CCommunicate::allreduceOr(&HaveOriginalPids, 1);
+
+  if (!HaveOriginalPids)
+    return;
+
+  // Nodes of partitions which are not relabeled keep their ids.
+  std::vector< size_t > OriginalPids(mLocalNodesSize + mExternalNodesSize);
+
+  for (size_t i = 0; i < mLocalNodesSize; ++i)
+    OriginalPids[i] = mLocalNodes[i].id;
+
+  for (size_t i = 0; i < mExternalNodesSize; ++i)
+    OriginalPids[mLocalNodesSize + i] = mExternalNodes[i].id;
+
+  for (pThread = Context.beginThread(); pThread != pThreadEnd; ++pThread)
+    {
+      std::copy(pThread->mOriginalPids.begin(), pThread->mOriginalPids.end(), OriginalPids.begin() + (pThread->mLocalNodes - mLocalNodes));
+      std::vector< size_t >().swap(pThread->mOriginalPids);
+    }
+
+  mOriginalPids.swap(OriginalPids);
+  mHaveOriginalPids = true;
+
+  // The original PIDs of the external nodes are provided by their owners.
+  CCommunicate::Send SendRequests(&CNetwork::sendOriginalPidRequests);
+  CCommunicate::Receive ReceiveRequests(&CNetwork::receiveOriginalPidRequests);
+  CCommunicate::roundRobin(&SendRequests, &ReceiveRequests);
+
+  CCommunicate::Send SendPids(&CNetwork::sendOriginalPids);
+  CCommunicate::Receive ReceivePids(&CNetwork::receiveOriginalPids);
+  CCommunicate::roundRobin(&SendPids, &ReceivePids);
+
+  mOriginalPidReplies.clear();
+
+  mNodesByOriginalPid.reserve(mOriginalPids.size());
+
+  for (size_t i = 0; i < mLocalNodesSize; ++i)
+    if (mLocalNodes[i].id != std::numeric_limits< size_t >::max())
+      mNodesByOriginalPid[mOriginalPids[i]] = mLocalNodes + i;
+
+  for (size_t i = 0; i < mExternalNodesSize; ++i)
+    mNodesByOriginalPid[mOriginalPids[mLocalNodesSize + i]] = mExternalNodes + i;
+
+  CLogger::info("Network: Translating PIDs of relabeled partitions for '{}' nodes.", mNodesByOriginalPid.size());
+}
+
+// static
+CCommunicate::ErrorCode CNetwork::sendOriginalPidRequests(std::ostream & os, int /* receiver */)
+{
+  CNetwork & Master = Context.Master();
+
+  for (size_t i = 0; i < Master.mExternalNodesSize; ++i)
+    os.write(reinterpret_cast< const char * >(&Master.mExternalNodes[i].id), sizeof(size_t));
+
+  return CCommunicate::ErrorCode::Success;
+}
+
+// static
+CCommunicate::ErrorCode CNetwork::receiveOriginalPidRequests(std::istream & is, int sender)
+{
+  CNetwork & Master = Context.Master();
+  std::vector< size_t > & Replies = Master.mOriginalPidReplies[sender];
+  size_t Id;
+
+  while (true)
+    {
+      is.read(reinterpret_cast< char * >(&Id), sizeof(size_t));
+
+      if (is.fail())
+        break;
+
+      CNode * pNode = Master.lookupNode(Id, true);
+
+      if (pNode == NULL)
+        continue;
+
+      Replies.push_back(Id);
+      Replies.push_back(Master.mOriginalPids[Master.nodeIndex(pNode)]);
+    }
+
+  return CCommunicate::ErrorCode::Success;
+}
+
+// static
+CCommunicate::ErrorCode CNetwork::sendOriginalPids(std::ostream & os, int receiver)
+{
+  CNetwork & Master = Context.Master();
+  std::map< int, std::vector< size_t > >::const_iterator found = Master.mOriginalPidReplies.find(receiver);
+
+  if (found != Master.mOriginalPidReplies.end())
+    os.write(reinterpret_cast< const char * >(found->second.data()), found->second.size() * sizeof(size_t));
+
+  return CCommunicate::ErrorCode::Success;
+}
+
+// static
+CCommunicate::ErrorCode CNetwork::receiveOriginalPids(std::istream & is, int /* sender */)
+{
+  CNetwork & Master = Context.Master();
+  size_t Reply[2];
+
+  while (true)
+    {
+      is.read(reinterpret_cast< char * >(Reply), 2 * sizeof(size_t));
+
+      if (is.fail())
+        break;
+
+      size_t Index = Master.nodeIndex(Master.lookupNode(Reply[0], false));
+
+      if (Index < Master.mOriginalPids.size())
+        Master.mOriginalPids[Index] = Reply[1];
+    }
+
+  return CCommunicate::ErrorCode::Success;
+}
+
+// static
+const size_t & CNetwork::OriginalPid(const CNode * pNode)
+{
+  const CNetwork & Master = Context.Master();
+
+  if (!Master.mHaveOriginalPids)
+    return pNode->id;
+
+  size_t Index = Master.nodeIndex(pNode);
+
+  // Temporary nodes are not relabeled
+  if (Index >= Master.mOriginalPids.size())
+    return pNode->id;
+
+  return Master.mOriginalPids[Index];
+}
+
+// static
+const CNetwork::sEdgeNodes & CNetwork::EdgeNodes(const CEdge * pEdge)
+{
+  static const sEdgeNodes NoNodes = {NULL, NULL};
+
+  // Edges are most often accessed by the thread which owns them.
+  const CNetwork * pNetwork = &Context.Active();
+
+  if (pNetwork->mEdges <= pEdge
+      && pEdge < pNetwork->mEdges + pNetwork->mEdgeNodes.size())
+    return pNetwork->mEdgeNodes[pEdge - pNetwork->mEdges];
+
+  const CNetwork * pEnd = Context.endThread();
+
+  for (pNetwork = Context.beginThread(); pNetwork != pEnd; ++pNetwork)
+    if (pNetwork->mEdges <= pEdge
+        && pEdge < pNetwork->mEdges + pNetwork->mEdgeNodes.size())
+      return pNetwork->mEdgeNodes[pEdge - pNetwork->mEdges];
+
+  return NoNodes;
+}
+
+// static
+bool CNetwork::HaveOriginalPids()
+{
+  return Context.Master().mHaveOriginalPids;
+}
+
+CNode * CNetwork::lookupOriginalPid(const size_t & pid, const bool localOnly) const
+{
+  const CNetwork & Master = Context.Master();
+
+  if (!Master.mHaveOriginalPids)
+    return lookupNode(pid, localOnly);
+
+  std::unordered_map< size_t, CNode * >::const_iterator found = Master.mNodesByOriginalPid.find(pid);
+
+  if (found == Master.mNodesByOriginalPid.end())
+    return NULL;
+
+  // The id determines whether the node is local.
+  return lookupNode(found->second->id, localOnly);
+}
+
+void CNetwork::initNodeIndex()
+{
+  mNodeIndex.init(mLocalNodes, mLocalNodes + mLocalNodesSize, mRemoteNodes);
+}
+
+// The order of the secondary edge index
+static bool lessBySource(const CEdge & lhs, const CEdge & rhs)
+{
+  if (lhs.sourceId != rhs.sourceId)
+    return lhs.sourceId < rhs.sourceId;
+
+  if (lhs.targetActivity != rhs.targetActivity)
+    return lhs.targetActivity < rhs.targetActivity;
+
+  if (lhs.sourceActivity != rhs.sourceActivity)
+    return lhs.sourceActivity < rhs.sourceActivity;
+
+#ifdef USE_LOCATION_ID
+  if (lhs.locationId != rhs.locationId)
+    return lhs.locationId < rhs.locationId;
+#endif
+
+  return false;
+}
+
+void CNetwork::initEdgeIndex()
 {
 #pragma omp parallel
   {
     CNetwork & Active = Context.Active();
-    std::map< CNode *, std::vector< CEdge * > > OutgoingEdges;
-    CEdge * pEdge = Active.beginEdge();
+    Active.mEdgesBySource.resize(Active.mEdgesSize);
+
+    CNode * pNode = Active.beginNode();
+    CNode * pNodeEnd = Active.endNode();
+
+    for (; pNode != pNodeEnd; ++pNode)
+      {
+        if (pNode->EdgesSize == 0)
+          continue;
+
+        const CEdge * pEdges = pNode->Edges;
+        unsigned int * pBegin = Active.mEdgesBySource.data() + (pNode->Edges - Active.mEdges);
+        unsigned int * pEnd = pBegin + pNode->EdgesSize;
+
+        for (unsigned int i = 0; i < pNode->EdgesSize; ++i)
+          pBegin[i] = i;
+
+        // Edges which are equal in the index order keep their order in the network.
+        std::sort(pBegin, pEnd, [pEdges](const unsigned int & lhs, const unsigned int & rhs) {
+          if (lessBySource(pEdges[lhs], pEdges[rhs]))
+            return true;
+
+          if (lessBySource(pEdges[rhs], pEdges[lhs]))
+            return false;
+
+          return lhs < rhs;
+        });
+      }
+  }
+}
+
+void CNetwork::initOutgoingEdges()
+{
+  // All sources are either local or external nodes of the master.
+  CNetwork & Master = Context.Master();
+
+#pragma omp parallel
+  {
+    CNetwork & Active = Context.Active();
+    CEdge * pEdgeBegin = Active.beginEdge();
     CEdge * pEdgeEnd = Active.endEdge();
+    CEdge * pEdge;
+    sEdgeNodes * pEdgeNodes;
 
-    for (; pEdge != pEdgeEnd; ++pEdge)
+    size_t First = std::numeric_limits< size_t >::max();
+    size_t Beyond = 0;
+
+    // Resolve the sources and determine the range of their indexes.
+    for (pEdge = pEdgeBegin, pEdgeNodes = Active.mEdgeNodes.data(); pEdge != pEdgeEnd; ++pEdge, ++pEdgeNodes)
       {
-        if (pEdge->pSource == NULL)
+        if (pEdgeNodes->pSource == NULL)
+          pEdgeNodes->pSource = Active.lookupNode(pEdge->sourceId, false);
+
+        if (pEdgeNodes->pSource == NULL)
           {
-            pEdge->pSource = Active.lookupNode(pEdge->sourceId, false);
+            CLogger::error("Network file: '{}' Source not found {}, {}, {}.", Active.mFile, pEdge - Active.beginEdge(), pEdge->targetId, pEdge->sourceId);
+            mValid = false; // DONE
+            continue;
+          }
 
-            if (pEdge->pSource == NULL)
-              {
-                CLogger::error("Network file: '{}' Source not found {}, {}, {}.", Active.mFile, pEdge - Active.beginEdge(), pEdge->targetId, pEdge->sourceId);
-                mValid = false; // DONE
-              }
+        size_t Index = Master.nodeIndex(pEdgeNodes->pSource);
+
+        if (Index < First)
+          First = Index;
+
+        if (Index >= Beyond)
+          Beyond = Index + 1;
+      }
+
+    if (First < Beyond)
+      {
+        // Offsets[i + 1] is the out degree of the source with index First + i.
+        std::vector< size_t > Offsets(Beyond - First + 1, 0);
+
+        for (pEdge = pEdgeBegin, pEdgeNodes = Active.mEdgeNodes.data(); pEdge != pEdgeEnd; ++pEdge, ++pEdgeNodes)
+          if (pEdgeNodes->pSource != NULL)
+            ++Offsets[Master.nodeIndex(pEdgeNodes->pSource) - First + 1];
+
+        // Offsets[i] is the begin of the outgoing edges of the source with index First + i.
+        for (size_t i = 1; i < Offsets.size(); ++i)
+          Offsets[i] += Offsets[i - 1];
+
+        Active.mOutgoingEdges.resize(Offsets.back());
+
+        // Offsets[i] becomes the end of the outgoing edges of the source with index First + i.
+        for (pEdge = pEdgeBegin, pEdgeNodes = Active.mEdgeNodes.data(); pEdge != pEdgeEnd; ++pEdge, ++pEdgeNodes)
+          if (pEdgeNodes->pSource != NULL)
+            Active.mOutgoingEdges[Offsets[Master.nodeIndex(pEdgeNodes->pSource) - First]++] = pEdge;
+
+        size_t Begin = 0;
+
+        for (size_t i = 0; i < Offsets.size() - 1; Begin = Offsets[i], ++i)
+          {
+            if (Offsets[i] == Begin)
+              continue;
+
+            size_t Index = First + i;
+            CNode * pSource = Index < Master.mLocalNodesSize ? Master.mLocalNodes + Index : Master.mExternalNodes + (Index - Master.mLocalNodesSize);
+            CNode::sOutgoingEdges & OutgoingEdges = pSource->OutgoingEdges.Active();
+
+            OutgoingEdges.pEdges = Active.mOutgoingEdges.data() + Begin;
+            OutgoingEdges.Size = Offsets[i] - Begin;
           }
-        else
-          OutgoingEdges[pEdge->pSource].push_back(pEdge);
       }
+  }
+}
 
-    std::map< CNode *, std::vector< CEdge * > >::const_iterator it = OutgoingEdges.begin();
-    std::map< CNode *, std::vector< CEdge * > >::const_iterator end = OutgoingEdges.end();
+void CNetwork::initMirror()
+{
+  if (!CSimConfig::getTransmissionMirror())
+    return;
 
-    for (; it != end; ++it)
-      {
-        CNode::sOutgoingEdges & OutgoingEdges = it->first->OutgoingEdges.Active();
+  // All nodes are owned by the master, i.e., the mirror is shared by all threads.
+  size_t Size = mLocalNodesSize + mExternalNodesSize;
 
-        OutgoingEdges.Size = it->second.size();
-        OutgoingEdges.pEdges = new CEdge *[OutgoingEdges.Size];
+  CLogger::info("Network: Allocating transmission mirror for nodes '{}' ({} bytes).", Size, Size * sizeof(sNodeMirror));
 
-        std::vector< CEdge * >::const_iterator itEdge = it->second.begin();
-        std::vector< CEdge * >::const_iterator endEdge = it->second.end();
-        CEdge ** ppEdge = OutgoingEdges.pEdges;
+  mpNodeMirror = new sNodeMirror[Size];
+
+  CNode * pNode = mLocalNodes;
+  CNode * pNodeEnd = mLocalNodes + mLocalNodesSize;
 
-        for (; itEdge != endEdge; ++itEdge, ++ppEdge)
-          *ppEdge = *itEdge;
+  for (; pNode != pNodeEnd; ++pNode)
+    MirrorNode(pNode);
+
+  pNode = mExternalNodes;
+  pNodeEnd = mExternalNodes + mExternalNodesSize;
+
+  for (; pNode != pNodeEnd; ++pNode)
+    MirrorNode(pNode);
+
+#pragma omp parallel
+  {
+    CNetwork & Active = Context.Active();
+
+    Active.mEdgeMirror.pActive = new bool[Active.mEdgesSize];
+    Active.mEdgeMirror.pWeight = new double[Active.mEdgesSize];
+    Active.mEdgeMirror.pDuration = new double[Active.mEdgesSize];
+    Active.mEdgeMirror.pSource = new size_t[Active.mEdgesSize];
+
+    CEdge * pEdge = Active.beginEdge();
+    CEdge * pEdgeEnd = Active.endEdge();
+
+    for (; pEdge != pEdgeEnd; ++pEdge)
+      {
+        MirrorEdge(pEdge);
+        Active.mEdgeMirror.pSource[pEdge - Active.mEdges] = nodeIndex(Active.mEdgeNodes[pEdge - Active.mEdges].pSource);
       }
   }
 }
 
+void CNetwork::initFrontier()
+{
+  // The frontier is determined from scratch since the node data are not modified through
+  // the setters while loading.
+  mHaveFrontier = false;
+
+  CNetwork * pNetwork = Context.beginThread();
+  CNetwork * pNetworkEnd = Context.endThread();
+
+  for (; pNetwork != pNetworkEnd; ++pNetwork)
+    {
+      pNetwork->mFrontierBits.assign((pNetwork->mLocalNodesSize + FrontierWordBits - 1) / FrontierWordBits, 0);
+      pNetwork->mFrontier.clear();
+    }
+
+  CNode * pNode = mLocalNodes;
+  CNode * pNodeEnd = mLocalNodes + mLocalNodesSize;
+
+  for (; pNode != pNodeEnd; ++pNode)
+    {
+      pNode->infectiousSources = 0;
+      pNode->isInfectious = false;
+    }
+
+  pNode = mExternalNodes;
+  pNodeEnd = mExternalNodes + mExternalNodesSize;
+
+  for (; pNode != pNodeEnd; ++pNode)
+    {
+      pNode->infectiousSources = 0;
+      pNode->isInfectious = false;
+    }
+
+  mHaveFrontier = true;
+
+  for (pNode = mLocalNodes, pNodeEnd = mLocalNodes + mLocalNodesSize; pNode != pNodeEnd; ++pNode)
+    UpdateFrontier(pNode);
+
+  for (pNode = mExternalNodes, pNodeEnd = mExternalNodes + mExternalNodesSize; pNode != pNodeEnd; ++pNode)
+    UpdateFrontier(pNode);
+}
+
+size_t CNetwork::nodeIndex(const CNode * pNode) const
+{
+  if (mLocalNodes <= pNode && pNode < mLocalNodes + mLocalNodesSize)
+    return pNode - mLocalNodes;
+
+  if (mExternalNodes <= pNode && pNode < mExternalNodes + mExternalNodesSize)
+    return mLocalNodesSize + (pNode - mExternalNodes);
+
+  return std::numeric_limits< size_t >::max();
+}
+
+// static
+void CNetwork::MirrorNode(const CNode * pNode)
+{
+  CNetwork & Master = Context.Master();
+
+  if (Master.mpNodeMirror == NULL)
+    return;
+
+  size_t Index = Master.nodeIndex(pNode);
+
+  // Temporary nodes are not mirrored
+  if (Index == std::numeric_limits< size_t >::max())
+    return;
+
+  sNodeMirror & Mirror = Master.mpNodeMirror[Index];
+  Mirror.infectivity = pNode->infectivity;
+  Mirror.healthState = pNode->healthState;
+}
+
+// static
+void CNetwork::MirrorEdge(const CEdge * pEdge)
+{
+  if (Context.Master().mpNodeMirror == NULL)
+    return;
+
+  CNetwork * pNetwork = &Context.Active();
+
+  // Edges are usually modified by the thread owning them.
+  if (pNetwork->mEdgeMirror.pActive == NULL
+      || pEdge < pNetwork->mEdges
+      || pNetwork->mEdges + pNetwork->mEdgesSize <= pEdge)
+    {
+      CNetwork * pEnd = Context.endThread();
+
+      for (pNetwork = Context.beginThread(); pNetwork != pEnd; ++pNetwork)
+        if (pNetwork->mEdges <= pEdge && pEdge < pNetwork->mEdges + pNetwork->mEdgesSize)
+          break;
+
+      if (pNetwork == pEnd)
+        return;
+    }
+
+  size_t Index = pEdge - pNetwork->mEdges;
+
+  pNetwork->mEdgeMirror.pActive[Index] = pEdge->active;
+  pNetwork->mEdgeMirror.pWeight[Index] = pEdge->weight;
+  pNetwork->mEdgeMirror.pDuration[Index] = pEdge->duration;
+}
+
+// static
+void CNetwork::UpdateFrontier(CNode * pNode)
+{
+  bool Infectious = pNode->infectivity > 0.0;
+
+  if (Infectious == pNode->isInfectious)
+    return;
+
+  CNetwork & Master = Context.Master();
+
+  // Temporary nodes and nodes modified while loading are not tracked
+  if (!Master.mHaveFrontier
+      || Master.nodeIndex(pNode) == std::numeric_limits< size_t >::max())
+    return;
+
+  pNode->isInfectious = Infectious;
+  int Delta = Infectious ? 1 : -1;
+
+  // The outgoing edges of each thread point to targets owned by that thread.
+  CNode::sOutgoingEdges * pOutgoing = pNode->OutgoingEdges.beginThread();
+  CNode::sOutgoingEdges * pOutgoingEnd = pNode->OutgoingEdges.endThread();
+  CNetwork * pNetwork = Context.beginThread();
+
+  for (; pOutgoing != pOutgoingEnd; ++pOutgoing, ++pNetwork)
+    {
+      CEdge ** ppEdge = pOutgoing->pEdges;
+      CEdge ** ppEdgeEnd = ppEdge + pOutgoing->Size;
+
+      for (; ppEdge != ppEdgeEnd; ++ppEdge)
+        {
+          CNode * pTarget = pNetwork->mEdgeNodes[*ppEdge - pNetwork->mEdges].pTarget;
+          int Count;
+
+#pragma omp atomic capture
+          Count = pTarget->infectiousSources += Delta;
+
+          if (Count == 1 && Infectious)
+            {
+              size_t Index = pTarget - pNetwork->mLocalNodes;
+              size_t Bit = size_t(1) << (Index % FrontierWordBits);
+
+#pragma omp atomic
+              pNetwork->mFrontierBits[Index / FrontierWordBits] |= Bit;
+            }
+        }
+    }
+}
+
+const std::vector< CNode * > & CNetwork::getFrontier()
+{
+  // The bits are scanned in network order, which preserves the sequence of random numbers.
+  // Targets which lost all infectious sources are removed lazily.
+  mFrontier.clear();
+
+  std::vector< size_t >::iterator itWord = mFrontierBits.begin();
+  std::vector< size_t >::iterator endWord = mFrontierBits.end();
+  CNode * pFirst = mLocalNodes;
+
+  for (; itWord != endWord; ++itWord, pFirst += FrontierWordBits)
+    if (*itWord != 0)
+      {
+        size_t Word = *itWord;
+        CNode * pNode = pFirst;
+
+        for (size_t Bit = 1; Word != 0; Bit <<= 1, ++pNode)
+          if (Word & Bit)
+            {
+              Word &= ~Bit;
+
+              if (pNode->infectiousSources > 0)
+                mFrontier.push_back(pNode);
+              else
+                *itWord &= ~Bit;
+            }
+      }
+
+  return mFrontier;
+}
+
+const CNetwork::sNodeMirror * CNetwork::getNodeMirror() const
+{
+  return mpNodeMirror;
+}
+
+const CNetwork::sEdgeMirror & CNetwork::getEdgeMirror() const
+{
+  return mEdgeMirror;
+}
+
 void CNetwork::writePreamble(std::ostream & os) const
 {
   os << CSimConfig::jsonToString(mpJson) << std::endl;
@@ -1282,7 +2316,8 @@ bool CNetwork::openPartition(const size_t & partition,
                              const size_t & beyondLocalNode,
                              const size_t & edgeCount,
                              const std::string & outputDirectory,
-                             std::ofstream & os)
+                             std::ofstream & os,
+                             const std::vector< size_t > * pOriginalPids)
 {
   std::string FileName = mFile;
 
@@ -1292,6 +2327,31 @@ bool CNetwork::openPartition(const size_t & partition,
       CDirEntry::makePathAbsolute(FileName, outputDirectory);
     }
 
+  std::ostringstream File;
+  File << FileName << "." << partition - 1;
+
+  os.open(File.str().c_str());
+
+  if (os.fail())
+    {
+      std::cout << File.str() << std::endl;
+      return false;
+    }
+
+  json_t * pPartition = json_object();
+  json_object_set_new(pPartition, "numberOfParts", json_integer(partCount));
+  json_object_set_new(pPartition, "numberOfNodes", json_integer(nodeCount));
+  json_object_set_new(pPartition, "firstLocalNode", json_integer(firstLocalNode));
+  json_object_set_new(pPartition, "beyondLocalNode", json_integer(beyondLocalNode));
+  json_object_set_new(pPartition, "numberOfEdges", json_integer(edgeCount));
+
+  writeBinaryPreamble(os, pPartition, pOriginalPids);
+
+  return true;
+}
+
+void CNetwork::writeBinaryPreamble(std::ostream & os, json_t * pPartition, const std::vector< size_t > * pOriginalPids) const
+{
   json_t * pJson = json_deep_copy(mpJson);
   json_t * pValue = json_object_get(pJson, "encoding");
 
@@ -1300,38 +2360,70 @@ bool CNetwork::openPartition(const size_t & partition,
       json_string_set(pValue, "binary");
     }
 
-  json_object_set_new(pJson, "partition", json_object());
+  // The preamble may have been modified by dumpActiveNetwork
+  json_object_set_new(pJson, "numberOfNodes", json_integer(mTotalNodesSize));
+  json_object_set_new(pJson, "numberOfEdges", json_integer(mTotalEdgesSize));
 
-  pValue = json_object_get(pJson, "partition");
-  json_object_set_new(pValue, "numberOfParts", json_integer(partCount));
-  json_object_set_new(pValue, "numberOfNodes", json_integer(nodeCount));
-  json_object_set_new(pValue, "firstLocalNode", json_integer(firstLocalNode));
-  json_object_set_new(pValue, "beyondLocalNode", json_integer(beyondLocalNode));
-  json_object_set_new(pValue, "numberOfEdges", json_integer(edgeCount));
+  if (pPartition != NULL)
+    json_object_set_new(pJson, "partition", pPartition);
+  else
+    json_object_del(pJson, "partition");
 
-  std::ostringstream File;
-  File << FileName << "." << partition - 1;
+  std::string Header;
 
-  os.open(File.str().c_str());
+  if (CEdge::HasLocationId)
+    Header = "targetPID,targetActivity,sourcePID,sourceActivity,duration,LID,edgeTrait,active,weight\n";
+  else
+    Header = "targetPID,targetActivity,sourcePID,sourceActivity,duration,edgeTrait,active,weight\n";
 
-  if (os.fail())
+  if (pPartition == NULL)
     {
-      std::cout << File.str() << std::endl;
-      return false;
+      os << CSimConfig::jsonToString(pJson) << std::endl;
+      os << Header;
     }
+  else
+    {
+      // Partitions are written in version 2 where the edge block starts at an offset
+      // aligned to 64KiB, which is a multiple of all common page sizes. This allows 
+      // load() to memory map the edges.
+      static const size_t EdgeAlignment = 65536;
 
-  os << CSimConfig::jsonToString(pJson) << std::endl;
+      json_object_set_new(pPartition, "version", json_integer(2));
+      json_object_set_new(pPartition, "sizeofEdge", json_integer(sizeof(CEdge)));
 
-  if (CEdge::HasLocationId)
-    os << "targetPID,targetActivity,sourcePID,sourceActivity,duration,LID,edgeTrait,active,weight";
-  else
-    os << "targetPID,targetActivity,sourcePID,sourceActivity,duration,edgeTrait,active,weight";
+      // The original PIDs of relabeled partitions are stored as a binary block immediately before the edges.
+      size_t PidSize = 0;
 
-  os << std::endl;
+      if (pOriginalPids != NULL)
+        {
+          PidSize = pOriginalPids->size() * sizeof(size_t);
+          json_object_set_new(pPartition, "numberOfOriginalPIDs", json_integer(pOriginalPids->size()));
+        }
+
+      size_t EdgeOffset = (PidSize / EdgeAlignment) * EdgeAlignment;
+      std::string Preamble;
+
+      // The size of the preamble depends on the offsets it contains.
+      do
+        {
+          EdgeOffset += EdgeAlignment;
+          json_object_set_new(pPartition, "edgeOffset", json_integer(EdgeOffset));
+
+          if (pOriginalPids != NULL)
+            json_object_set_new(pPartition, "originalPIDOffset", json_integer(EdgeOffset - PidSize));
+
+          Preamble = CSimConfig::jsonToString(pJson) + "\n" + Header;
+        }
+      while (Preamble.size() + PidSize > EdgeOffset);
+
+      os << Preamble;
+      os << std::string(EdgeOffset - PidSize - Preamble.size(), '\0');
+
+      if (PidSize > 0)
+        os.write(reinterpret_cast< const char * >(pOriginalPids->data()), PidSize);
+    }
 
   json_decref(pJson);
-  
-  return true;
 }
 
 void CNetwork::writePartition(const size_t & partition,
@@ -1389,6 +2481,16 @@ bool CNetwork::haveValidPartition(const int & parts)
 
           valid &= (json_is_integer(pValue) && json_integer_value(pValue) == parts);
 
+          // Version 2 partitions contain edge images which must match the build.
+          pValue = json_object_get(pPartition, "version");
+
+          if (json_is_integer(pValue)
+              && json_integer_value(pValue) >= 2)
+            {
+              pValue = json_object_get(pPartition, "sizeofEdge");
+              valid &= (json_is_integer(pValue) && (size_t) json_integer_value(pValue) == sizeof(CEdge));
+            }
+
           pValue = json_object_get(pJson, "encoding");
 
           valid &= (json_is_string(pValue) && strcmp(json_string_value(pValue), "binary") == 0);
@@ -1400,10 +2502,42 @@ bool CNetwork::haveValidPartition(const int & parts)
           valid = false;
         }
 
-      haveValidPartition &= valid;
+      haveValidPartition &= valid;
+    }
+
+  return haveValidPartition;
+}
+
+bool CNetwork::mapEdges()
+{
+  int File = open(mFile.c_str(), O_RDONLY);
+
+  if (File < 0)
+    return false;
+
+  struct stat Stat;
+  mEdgeMapSize = mEdgesSize * sizeof(CEdge);
+
+  if (fstat(File, &Stat) != 0
+      || (size_t) Stat.st_size < mEdgeOffset + mEdgeMapSize)
+    {
+      close(File);
+      return false;
     }
 
-  return haveValidPartition;
+  // The mapping is private since edges may be modified by interventions, i.e., only
+  // pages which are written to are copied. The nodes of the edges are kept separately
+  // so that loading does not write to the mapping.
+  void * pMap = mmap(NULL, mEdgeMapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, File, mEdgeOffset);
+  close(File);
+
+  if (pMap == MAP_FAILED)
+    return false;
+
+  mpEdgeMap = static_cast< char * >(pMap);
+  mEdges = reinterpret_cast< CEdge * >(mpEdgeMap);
+
+  return true;
 }
 
 CNode * CNetwork::beginNode()
@@ -1426,17 +2560,17 @@ CEdge * CNetwork::endEdge()
   return mEdges + mEdgesSize;
 }
 
-const std::map< size_t, CNode * > & CNetwork::getRemoteNodes() const
+const std::vector< std::pair< size_t, CNode * > > & CNetwork::getRemoteNodes() const
 {
   return mRemoteNodes;
 }
 
-std::map< size_t, CNode * >::const_iterator CNetwork::beginRemoteNodes() const
+std::vector< std::pair< size_t, CNode * > >::const_iterator CNetwork::beginRemoteNodes() const
 {
   return mRemoteNodes.begin();
 }
   
-std::map< size_t, CNode * >::const_iterator CNetwork::endRemoteNodes() const
+std::vector< std::pair< size_t, CNode * > >::const_iterator CNetwork::endRemoteNodes() const
 {
   return mRemoteNodes.end();
 }
@@ -1448,11 +2582,28 @@ bool CNetwork::isRemoteNode(const CNode * pNode) const
 
 bool CNetwork::isRemoteNode(const size_t & id) const
 {
+  if (Context.Master().mNodeIndex.isValid())
+    return lookupNode(id, true) == NULL;
+
   return id < mLocalNodes->id || (mLocalNodes + mLocalNodesSize - 1)->id < id;
 }
 
 CNode * CNetwork::lookupNode(const size_t & id, const bool localOnly) const
 {
+  const CNodeIndex & NodeIndex = Context.Master().mNodeIndex;
+
+  if (NodeIndex.isValid())
+    {
+      CNode * pNode = NodeIndex.lookup(id);
+
+      if (localOnly
+          && pNode != NULL
+          && isRemoteNode(pNode))
+        return NULL;
+
+      return pNode;
+    }
+
   if (id < mFirstLocalNode || mBeyondLocalNode <= id)
     {
       if (!localOnly)
@@ -1460,10 +2611,11 @@ CNode * CNetwork::lookupNode(const size_t & id, const bool localOnly) const
           if (Context.isThread(this))
             return Context.Master().lookupNode(id, false);
 
-          std::map< size_t, CNode * >::const_iterator found = mRemoteNodes.find(id);
+          std::vector< std::pair< size_t, CNode * > >::const_iterator found = std::lower_bound(mRemoteNodes.begin(), mRemoteNodes.end(), std::make_pair(id, (CNode *) NULL));
 
-          if (found != mRemoteNodes.end())
-            return const_cast< CNode * >(found->second);
+          if (found != mRemoteNodes.end()
+              && found->first == id)
+            return found->second;
         }
 
       return NULL;
@@ -1506,46 +2658,77 @@ CEdge * CNetwork::lookupEdge(const size_t & targetId, const size_t & sourceId) c
         return NULL;
     }
 
+  // The secondary edge index is owned by the thread of the target.
+  if (!Context.isThread(this)
+      && Context.size() > 1)
+    {
+      int Index = index(targetId);
+
+      if (Index < 0)
+        return NULL;
+
+      return (Context.beginThread() + Index)->lookupEdge(targetId, sourceId);
+    }
+
   CNode * pTargetNode = lookupNode(targetId, true);
 
   // Handle invalid requests
-  if (pTargetNode == NULL)
+  if (pTargetNode == NULL
+      || pTargetNode->EdgesSize == 0)
     return NULL;
 
-  // TODO CRITICAL This is broken since the edges are not sorted by source node Id
-  // furthermore the targetNodeId, sourceNodeId is not a unique index
-  CEdge * pLeft = pTargetNode->Edges;
-  CEdge * pRight = pLeft + pTargetNode->EdgesSize;
-  CEdge * pCurrent = pLeft + (pRight - pLeft) / 2;
+  CEdge * pEdges = pTargetNode->Edges;
 
-  while (pLeft <= pRight)
+  // The index is not yet available while loading.
+  if (mEdgesBySource.size() != mEdgesSize)
     {
-      if (pCurrent->sourceId < sourceId)
-        {
-          pLeft = pCurrent + 1;
-        }
-      else if (pCurrent->sourceId > sourceId)
-        {
-          pRight = pCurrent - 1;
-        }
-      else
-        {
-          return pCurrent;
-        }
+      CEdge * pFound = NULL;
 
-      pCurrent = pLeft + (pRight - pLeft) / 2;
+      for (CEdge * pEdge = pEdges, * pEdgeEnd = pEdges + pTargetNode->EdgesSize; pEdge != pEdgeEnd; ++pEdge)
+        if (pEdge->sourceId == sourceId
+            && (pFound == NULL || lessBySource(*pEdge, *pFound)))
+          pFound = pEdge;
+
+      return pFound;
     }
 
+  const unsigned int * pBegin = mEdgesBySource.data() + (pEdges - mEdges);
+  const unsigned int * pEnd = pBegin + pTargetNode->EdgesSize;
+  const unsigned int * pFound = std::lower_bound(pBegin, pEnd, sourceId, [pEdges](const unsigned int & index, const size_t & id) {
+    return pEdges[index].sourceId < id;
+  });
+
+  if (pFound != pEnd
+      && pEdges[*pFound].sourceId == sourceId)
+    return pEdges + *pFound;
+
   return NULL;
 }
 
+CEdge * CNetwork::lookupEdge(const size_t & targetId, const size_t & sourceId, const size_t & offset) const
+{
+  CNode * pTargetNode = lookupNode(targetId, true);
+
+  if (pTargetNode != NULL
+      && offset < pTargetNode->EdgesSize
+      && pTargetNode->Edges[offset].sourceId == sourceId)
+    return pTargetNode->Edges + offset;
+
+  return lookupEdge(targetId, sourceId);
+}
+
 bool CNetwork::loadEdge(CEdge * pEdge, std::istream & is) const
 {
   bool success = true;
 
   if (mIsBinary)
     {
-      pEdge->fromBinary(is);
+      if (mEdgeOffset > 0)
+        {
+          is.read(reinterpret_cast< char * >(pEdge), sizeof(CEdge));
+        }
+      else
+        pEdge->fromBinary(is);
 
       success = is.good() && (mFirstLocalNode == 0 || (mFirstLocalNode <= pEdge->targetId && pEdge->targetId < mBeyondLocalNode));
       if (!success)
@@ -1553,94 +2736,146 @@ bool CNetwork::loadEdge(CEdge * pEdge, std::istream & is) const
     }
   else
     {
-      char Line[1024];
-      size_t LineSize = 1024;
-
-      std::istream::pos_type p = is.tellg();
-
-      is.getline(Line, LineSize);
+      std::getline(is, mLine);
 
       if (is.fail())
         {
           return false;
         }
 
-      if (is.tellg() - p >= (int) LineSize)
-        {
-          CLogger::error("Edge line size exceeded.");
-          return false;
-        }
-
-      const char * ptr = Line;
-      int Read;
-
-      static char targetActivity[128];
-      static char sourceActivity[128];
-      static char edgeTrait[128];
-
-      if (5 != sscanf(ptr, "%zu,%[^,],%zu,%[^,],%lf%n", &pEdge->targetId, targetActivity, &pEdge->sourceId, sourceActivity, &pEdge->duration, &Read))
-        {
-          success = false;
-        }
+      const char * ptr = mLine.c_str();
 
-      success &= CTrait::ActivityTrait->fromString(targetActivity, pEdge->targetActivity);
-      success &= CTrait::ActivityTrait->fromString(sourceActivity, pEdge->sourceActivity);
-
-      ptr += Read;
+      success &= parseId(ptr, pEdge->targetId) && *ptr++ == ',';
+      success = success && parseTrait(CTrait::ActivityTrait, mActivityCache, ptr, pEdge->targetActivity) && *ptr++ == ',';
+      success = success && parseId(ptr, pEdge->sourceId) && *ptr++ == ',';
+      success = success && parseTrait(CTrait::ActivityTrait, mActivityCache, ptr, pEdge->sourceActivity) && *ptr++ == ',';
+      success = success && parseNumber(ptr, pEdge->duration);
 
 #ifdef USE_LOCATION_ID
       if (CEdge::HasLocationId)
-        {
-          if (1 != sscanf(ptr, ",%zu%n", &pEdge->locationId, &Read))
-            {
-              success = false;
-            }
-
-          ptr += Read;
-        }
+        success = success && *ptr++ == ',' && parseId(ptr, pEdge->locationId);
 #endif
 
       if (CEdge::HasEdgeTrait)
-        {
-          if (1 != sscanf(ptr, ",%[^,]%n", edgeTrait, &Read))
-            {
-              success = false;
-            }
-
-          CTrait::EdgeTrait->fromString(edgeTrait, pEdge->edgeTrait);
-          ptr += Read;
-        }
+        success = success && *ptr++ == ',' && parseTrait(CTrait::EdgeTrait, mEdgeTraitCache, ptr, pEdge->edgeTrait);
 
       if (CEdge::HasActiveField)
         {
-          char Active;
-
-          if (1 != sscanf(ptr, ",%c%n", &Active, &Read))
-            {
-              success = false;
-            }
+          success = success && *ptr++ == ',' && *ptr != 0;
 
-          pEdge->active = (Active == '1');
-          ptr += Read;
+          if (success)
+            pEdge->active = (*ptr++ == '1');
         }
 
       if (CEdge::HasWeightField)
-        {
-          if (1 != sscanf(ptr, ",%lf%n", &pEdge->weight, &Read))
-            {
-              success = false;
-            }
-
-          ptr += Read;
-        }
+        success = success && *ptr++ == ',' && parseNumber(ptr, pEdge->weight);
 
       if (success)
         success = (*ptr == 0 || *ptr == '\r');
 
       if (!success)
-        CLogger::error("CEdge: Invalid edge encoding '{}'.", Line);
+        CLogger::error("CEdge: Invalid edge encoding '{}'.", mLine);
+    }
+
+  return success;
+}
+
+// static
+bool CNetwork::parseId(const char *& ptr, size_t & value)
+{
+  const char * pStart = ptr;
+
+  value = 0;
+
+  while ('0' <= *ptr && *ptr <= '9')
+    value = 10 * value + (*ptr++ - '0');
+
+  return ptr != pStart;
+}
+
+// static
+bool CNetwork::parseNumber(const char *& ptr, double & value)
+{
+  // Powers of ten which are exactly representable as double
+  static const double Power[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  const char * pStart = ptr;
+  bool Negative = (*ptr == '-');
+
+  if (Negative || *ptr == '+')
+    ++ptr;
+
+  size_t Mantissa = 0;
+  size_t Digits = 0;
+  size_t Fraction = 0;
+
+  while ('0' <= *ptr && *ptr <= '9')
+    {
+      Mantissa = 10 * Mantissa + (*ptr++ - '0');
+      ++Digits;
+    }
+
+  if (*ptr == '.')
+    {
+      ++ptr;
+
+      while ('0' <= *ptr && *ptr <= '9')
+        {
+          Mantissa = 10 * Mantissa + (*ptr++ - '0');
+          ++Digits;
+          ++Fraction;
+        }
+    }
+
+  // The fast path is exact since both the mantissa and the power of ten are exactly
+  // representable, i.e., the division is correctly rounded. Everything else, e.g.,
+  // exponents, is handled by strtod.
+  if (Digits > 0
+      && Digits <= 15
+      && *ptr != 'e'
+      && *ptr != 'E')
+    {
+      value = Mantissa / Power[Fraction];
+
+      if (Negative)
+        value = -value;
+
+      return true;
+    }
+
+  char * pEnd;
+  value = strtod(pStart, &pEnd);
+  ptr = pEnd;
+
+  return ptr != pStart;
+}
+
+bool CNetwork::parseTrait(const CTrait * pTrait, trait_cache & cache, const char *& ptr, CTraitData::base & value) const
+{
+  const char * pStart = ptr;
+
+  while (*ptr != ',' && *ptr != 0 && *ptr != '\r')
+    ++ptr;
+
+  mKey.assign(pStart, ptr - pStart);
+
+  trait_cache::const_iterator found = cache.find(mKey);
+
+  if (found != cache.end())
+    {
+      value = found->second;
+      return true;
     }
 
+  bool success;
+
+  // CTrait::fromString maintains a shared decoding cache.
+#pragma omp critical (network_parse_trait)
+  success = pTrait->fromString(mKey.c_str(), value);
+
+  if (success)
+    cache[mKey] = value;
 
   return success;
 }
@@ -1690,11 +2925,30 @@ const bool & CNetwork::isValid() const
   return mValid;
 }
 
-int CNetwork::broadcastChanges()
+int CNetwork::beginBroadcastChanges()
 {
+  CChanges::collectChangedNodes();
+
+  if (CSimConfig::getNodeExchange().mode != "nonBlocking")
+    return (int) CCommunicate::ErrorCode::Success;
+
   CCommunicate::Send SendNodes(&CChanges::sendNodesRequested);
+  return CCommunicate::startExchange(&SendNodes, CChanges::getRanksToSend());
+}
+
+int CNetwork::broadcastChanges()
+{
   CCommunicate::ClassMemberReceive< CNetwork > ReceiveNodes(this, &CNetwork::receiveNodes);
-  CCommunicate::roundRobin(&SendNodes, &ReceiveNodes);
+
+  if (CSimConfig::getNodeExchange().mode == "nonBlocking")
+    {
+      CCommunicate::finishExchange(CChanges::getRanksToReceive(), &ReceiveNodes);
+    }
+  else
+    {
+      CCommunicate::Send SendNodes(&CChanges::sendNodesRequested);
+      CCommunicate::roundRobin(&SendNodes, &ReceiveNodes);
+    }
 
   CChanges::reset();
 
@@ -1703,34 +2957,68 @@ int CNetwork::broadcastChanges()
 
 CCommunicate::ErrorCode CNetwork::receiveNodes(std::istream & is, int sender)
 {
-  size_t BufferSize = is.rdbuf()->in_avail() / 56;
+  // Each record is the index of the node in the nodes provided by the sender followed by its binary data.
+  static const size_t RecordSize = sizeof(size_t) + CNode::BinarySize;
+
+  const std::vector< CNode * > & RemoteNodes = CChanges::getRemoteNodes(sender);
+  size_t Size = is.rdbuf()->in_avail();
+  std::string Copy;
+  const char * pData = receiveData(is, Size, Copy);
+
+  if (CSimConfig::getNodeExchange().encoding == "compact")
+    return receiveCompactNodes(pData, Size, RemoteNodes, sender);
+
+  size_t Records = Size / RecordSize;
   size_t Count = 0;
+  bool Valid = true;
 
-#pragma omp parallel for shared(is) reduction(+: Count)
-  for (size_t i = 0; i < BufferSize; ++i)
-    {
-      CNode Node;
+#pragma omp parallel reduction(+: Count) reduction(&&: Valid)
+  {
+    // Each thread decodes its own slice of the records.
+    size_t Slice = (Records + omp_get_num_threads() - 1) / omp_get_num_threads();
+    size_t First = std::min(Records, omp_get_thread_num() * Slice);
+    size_t Beyond = std::min(Records, First + Slice);
 
-#pragma omp critical (receive_changes)
-      Node.fromBinary(is);
+    CStreamBuffer Buffer(const_cast< char * >(pData + First * RecordSize), (Beyond - First) * RecordSize);
+    std::istream ThreadStream(&Buffer);
+    CNode Node;
+    size_t Index;
 
-      CNode * pNode = lookupNode(Node.id, false);
+    for (size_t i = First; i < Beyond; ++i)
+      {
+        ThreadStream.read(reinterpret_cast< char * >(&Index), sizeof(size_t));
+        Node.fromBinary(ThreadStream);
 
-      // CLogger::debug() << "CNetwork::receiveNodes: Receiving node: '" << Node.id << "' (" << pNode << ").";
+        if (Index >= RemoteNodes.size())
+          {
+            Valid = false;
+            continue;
+          }
 
-      // TODO CSetCollector for non local nodes
-      if (pNode != NULL)
-        {
-          Count++;
-          ENABLE_TRACE(CLogger::trace("CChanges: updating node '{}'.", pNode->id););
-
-          pNode->susceptibilityFactor = Node.susceptibilityFactor;
-          pNode->susceptibility = Node.susceptibility;
-          pNode->infectivityFactor = Node.infectivityFactor;
-          pNode->infectivity = Node.infectivity;
-          pNode->nodeTrait = Node.nodeTrait;
-          pNode->setHealthState(Node.getHealthState());
-        }
+        CNode * pNode = RemoteNodes[Index];
+
+        // CLogger::debug() << "CNetwork::receiveNodes: Receiving node: '" << Node.id << "' (" << pNode << ").";
+
+        // TODO CSetCollector for non local nodes
+        if (pNode != NULL)
+          {
+            Count++;
+            ENABLE_TRACE(CLogger::trace("CChanges: updating node '{}'.", pNode->id););
+
+            pNode->susceptibilityFactor = Node.susceptibilityFactor;
+            pNode->susceptibility = Node.susceptibility;
+            pNode->infectivityFactor = Node.infectivityFactor;
+            pNode->infectivity = Node.infectivity;
+            pNode->nodeTrait = Node.nodeTrait;
+            pNode->setHealthState(Node.getHealthState());
+          }
+      }
+  }
+
+  if (!Valid)
+    {
+      CLogger::error("CNetwork::receiveNodes: Invalid data received from: '{}'.", sender);
+      return CCommunicate::ErrorCode::InvalidArguments;
     }
 
   CLogger::debug("CChanges::receiveNodes: Receiving '{}' nodes from: '{}'.", Count, sender);
@@ -1738,6 +3026,124 @@ CCommunicate::ErrorCode CNetwork::receiveNodes(std::istream & is, int sender)
   return CCommunicate::ErrorCode::Success;
 }
 
+// static
+const char * CNetwork::receiveData(std::istream & is, const size_t & size, std::string & copy)
+{
+  CStreamBuffer * pBuffer = dynamic_cast< CStreamBuffer * >(is.rdbuf());
+
+  if (pBuffer != NULL)
+    return pBuffer->current();
+
+  copy.resize(size);
+  is.read(&copy[0], size);
+
+  return copy.c_str();
+}
+
+// static
+CCommunicate::ErrorCode CNetwork::receiveCompactNodes(const char * pData, const size_t & size, const std::vector< CNode * > & remoteNodes, int sender)
+{
+  struct sBlock
+  {
+    const char * pData;
+    size_t Nodes;
+    size_t Size;
+  };
+
+  // Locate the blocks written by each of the sender's threads, which are decoded in parallel.
+  std::vector< sBlock > Blocks;
+
+  {
+    CStreamBuffer Buffer(const_cast< char * >(pData), size);
+    std::istream is(&Buffer);
+    sBlock Block;
+
+    while (CStreamBuffer::readVarint(is, Block.Nodes)
+           && CStreamBuffer::readVarint(is, Block.Size))
+      {
+        Block.pData = Buffer.current();
+
+        if (Block.pData + Block.Size > pData + size)
+          {
+            CLogger::error("CNetwork::receiveCompactNodes: Invalid data received from: '{}'.", sender);
+            return CCommunicate::ErrorCode::InvalidArguments;
+          }
+
+        Blocks.push_back(Block);
+        is.ignore(Block.Size);
+      }
+  }
+
+  size_t Count = 0;
+  bool Valid = true;
+
+#pragma omp parallel reduction(+: Count) reduction(&&: Valid)
+  {
+    CNode Node;
+
+#pragma omp for
+    for (size_t i = 0; i < Blocks.size(); ++i)
+      {
+        const sBlock & Block = Blocks[i];
+        CStreamBuffer Buffer(const_cast< char * >(Block.pData), Block.Size);
+        std::istream is(&Buffer);
+        size_t Index = 0;
+        size_t Delta;
+
+        for (size_t k = 0; k < Block.Nodes && Valid; ++k)
+          {
+            CStreamBuffer::readVarint(is, Delta);
+            Index += Delta;
+
+            unsigned char Fields = Node.fromCompactBinary(is);
+
+            if (Fields == 0
+                || Index >= remoteNodes.size())
+              {
+                Valid = false;
+                break;
+              }
+
+            CNode * pNode = remoteNodes[Index];
+
+            if (pNode == NULL)
+              continue;
+
+            Count++;
+            ENABLE_TRACE(CLogger::trace("CChanges: updating node '{}'.", pNode->id););
+
+            if (Fields & CNode::SusceptibilityFactorField)
+              pNode->susceptibilityFactor = Node.susceptibilityFactor;
+
+            if (Fields & CNode::SusceptibilityField)
+              pNode->susceptibility = Node.susceptibility;
+
+            if (Fields & CNode::InfectivityFactorField)
+              pNode->infectivityFactor = Node.infectivityFactor;
+
+            if (Fields & CNode::InfectivityField)
+              pNode->infectivity = Node.infectivity;
+
+            if (Fields & CNode::NodeTraitField)
+              pNode->nodeTrait = Node.nodeTrait;
+
+            // Setting the health state also updates the mirror and the frontier.
+            pNode->setHealthState((Fields & CNode::HealthStateField) ? CModel::StateFromType(Node.healthState) : pNode->getHealthState());
+          }
+      }
+  }
+
+  if (!Valid)
+    {
+      CLogger::error("CNetwork::receiveCompactNodes: Invalid data received from: '{}'.", sender);
+      return CCommunicate::ErrorCode::InvalidArguments;
+    }
+
+  CLogger::debug("CChanges::receiveCompactNodes: Receiving '{}' nodes from: '{}'.", Count, sender);
+
+  return CCommunicate::ErrorCode::Success;
+}
+
 const size_t & CNetwork::getLocalNodeCount() const
 {
   return mLocalNodesSize;
@@ -1780,8 +3186,9 @@ bool CNetwork::dumpActiveNetwork()
   {
     CNetwork & Active = Context.Active();
 
+    // The parts are specific to the tick as they may be concatenated in the background.
     std::ostringstream File;
-    File << dumpActiveNetwork.output << "." << Context.globalIndex(&Active);
+    File << dumpActiveNetwork.output << "[" << CurrentTick << "]." << Context.globalIndex(&Active);
 
     std::ofstream os;
     os.open(File.str().c_str());
@@ -1848,6 +3255,74 @@ bool CNetwork::dumpActiveNetwork()
   return Context.Master().concatenateDump();
 }
 
+// static
+bool CNetwork::writeCheckpoint(const std::string & file)
+{
+  bool success = true;
+
+  // The current edge state is preserved as a valid binary partition of the network.
+  if (CCommunicate::MPIRank == 0)
+    {
+      std::ofstream os(file.c_str());
+
+      Context.Master().writeBinaryPreamble(os, NULL);
+      success &= !os.fail();
+
+      os.close();
+    }
+
+#pragma omp parallel reduction(&: success)
+  {
+    CNetwork & Active = Context.Active();
+
+    std::ostringstream File;
+    File << file << "." << Context.globalIndex(&Active);
+
+    std::ofstream os(File.str().c_str());
+
+    if (os.fail())
+      {
+        success = false;
+      }
+    else
+      {
+        json_t * pPartition = json_object();
+        json_object_set_new(pPartition, "numberOfParts", json_integer(CCommunicate::TotalProcesses()));
+        json_object_set_new(pPartition, "numberOfNodes", json_integer(Active.mLocalNodesSize));
+        json_object_set_new(pPartition, "firstLocalNode", json_integer(Active.mLocalNodesSize > 0 ? Active.mLocalNodes->id : Active.mFirstLocalNode));
+        json_object_set_new(pPartition, "beyondLocalNode", json_integer(Active.mBeyondLocalNode));
+        json_object_set_new(pPartition, "numberOfEdges", json_integer(Active.mEdgesSize));
+
+        // The original PIDs of all local nodes are kept by the master.
+        if (Context.Master().mHaveOriginalPids)
+          {
+            std::vector< size_t >::const_iterator itPid = Context.Master().mOriginalPids.begin() + (Active.mLocalNodes - Context.Master().mLocalNodes);
+            std::vector< size_t > OriginalPids(itPid, itPid + Active.mLocalNodesSize);
+
+            Active.writeBinaryPreamble(os, pPartition, &OriginalPids);
+          }
+        else
+          {
+            Active.writeBinaryPreamble(os, pPartition);
+          }
+
+        CEdge * pEdge = Active.beginEdge();
+        CEdge * pEdgeEnd = Active.endEdge();
+
+        for (; pEdge != pEdgeEnd; ++pEdge)
+          pEdge->toImage(os);
+
+        success &= !os.fail();
+        os.close();
+      }
+
+    if (!success)
+      CLogger::error("CNetwork: Failed to write checkpoint '{}'.", File.str());
+  }
+
+  return success;
+}
+
 CCommunicate::ErrorCode CNetwork::receiveDump(std::istream & is, int sender)
 {
   if (CCommunicate::MPIRank == 0
@@ -1898,29 +3373,37 @@ bool CNetwork::concatenateDump()
   std::ostringstream File;
   File << dumpActiveNetwork.output << "[" << CActionQueue::getCurrentTick() << "]";
 
-  std::ofstream os;
-  os.open(File.str().c_str());
+  std::string Dump = File.str();
+  std::ostringstream Preamble;
 
   // write JSON preamble
-  writePreamble(os);
+  writePreamble(Preamble);
 
-  std::ifstream is;
-  int p = 0;
-  int pMax = CCommunicate::TotalProcesses();
+  std::shared_ptr< std::string > pPreamble = std::make_shared< std::string >(Preamble.str());
+  int Parts = CCommunicate::TotalProcesses();
 
-  for (; p < pMax; ++p)
-    {
-      File.str("");
-      File << dumpActiveNetwork.output << "." << p;
-      is.open(File.str().c_str());
-      os << is.rdbuf();
-      is.close();
+  return CAsyncWriter::submit(Dump, [Dump, pPreamble, Parts]
+  {
+    std::ofstream os;
+    os.open(Dump.c_str());
+    os << *pPreamble;
 
-      CDirEntry::remove(File.str());
-    }
+    std::ifstream is;
 
-  os.close();
+    for (int p = 0; p < Parts; ++p)
+      {
+        std::ostringstream Part;
+        Part << Dump << "." << p;
+        is.open(Part.str().c_str());
+        os << is.rdbuf();
+        is.close();
 
-  return true;
+        CDirEntry::remove(Part.str());
+      }
+
+    os.close();
+
+    return true;
+  });
 }
 
@@ -27,11 +27,16 @@
 
 #include <set>
 #include <map>
+#include <unordered_map>
+#include <string>
+#include <vector>
 #include <iostream>
 
+#include "traits/CTraitData.h"
 #include "utilities/CAnnotation.h"
 #include "utilities/CCommunicate.h"
 #include "utilities/CContext.h"
+#include "network/CNodeIndex.h"
 
 struct json_t;
 class CNode;
@@ -41,7 +46,14 @@ class CTrait;
 class CNetwork: public CAnnotation
 {
 private:
+  typedef std::map< std::string, CTraitData::base > trait_cache;
+
+  static const size_t NetworkBufferSize;
+
   bool loadEdge(CEdge * pEdge, std::istream & is) const;
+  static bool parseId(const char *& ptr, size_t & value);
+  static bool parseNumber(const char *& ptr, double & value);
+  bool parseTrait(const CTrait * pTrait, trait_cache & cache, const char *& ptr, CTraitData::base & value) const;
   void writeEdge(CEdge * pEdge, std::ostream & os) const;
   void partition(std::istream & is, const int & parts, const bool & save, const std::string & outputDirectory);
   void convert(std::istream & is, const std::string & outputDirectory);
@@ -52,7 +64,8 @@ private:
                      const size_t & beyondLocalNode,
                      const size_t & edgeCount,
                      const std::string & outputDirectory,
-                     std::ofstream & os);
+                     std::ofstream & os,
+                     const std::vector< size_t > * pOriginalPids = NULL);
 
   void writePartition(const size_t & partition,
                       const size_t & partCount,
@@ -63,6 +76,10 @@ private:
                       const std::string & edges,
                       const std::string & outputDirectory);
 
+  void writeBinaryPreamble(std::ostream & os, json_t * pPartition, const std::vector< size_t > * pOriginalPids = NULL) const;
+
+  bool mapEdges();
+
   struct dump_active_network
   {
     size_t Nodes;
@@ -70,6 +87,37 @@ private:
   };
 
 public:
+  /**
+   * The node data read by the transmission kernel, indexed by CNetwork::nodeIndex
+   */
+  struct sNodeMirror
+  {
+    double infectivity;
+    size_t healthState;
+  };
+
+  /**
+   * The edge data read by the transmission kernel, indexed by the position of the
+   * edge within the thread's edges
+   */
+  struct sEdgeMirror
+  {
+    bool * pActive;
+    double * pWeight;
+    double * pDuration;
+    size_t * pSource;
+  };
+
+  /**
+   * The nodes of an edge, which are kept outside of the edge data since these may be
+   * memory mapped, indexed by the position of the edge within the thread's edges
+   */
+  struct sEdgeNodes
+  {
+    CNode * pTarget;
+    CNode * pSource;
+  };
+
   static CContext< CNetwork > Context;
 
   static void init();
@@ -77,7 +125,49 @@ public:
   static int index(const CNode * pNode);
   static int index(const size_t & id);
   static bool dumpActiveNetwork();
+  static bool writeCheckpoint(const std::string & file);
   static double timeResolution();
+
+  /**
+   * Update the mirrored data of a node if the transmission mirror is enabled.
+   * @param const CNode * pNode
+   */
+  static void MirrorNode(const CNode * pNode);
+
+  /**
+   * Update the mirrored data of an edge if the transmission mirror is enabled.
+   * @param const CEdge * pEdge
+   */
+  static void MirrorEdge(const CEdge * pEdge);
+
+  /**
+   * Update the transmission frontier, i.e., the count of infectious sources of the
+   * targets of all outgoing edges, if the node's infectivity crossed zero.
+   * @param CNode * pNode
+   */
+  static void UpdateFrontier(CNode * pNode);
+
+  /**
+   * Retrieve the target and source nodes of an edge of any thread
+   * @param const CEdge * pEdge
+   * @return const sEdgeNodes & edgeNodes
+   */
+  static const sEdgeNodes & EdgeNodes(const CEdge * pEdge);
+
+  /**
+   * Retrieve the PID of the node in the original network, which differs from its id if the
+   * network was partitioned with relabeling.
+   * @param const CNode * pNode
+   * @return const size_t & pid
+   */
+  static const size_t & OriginalPid(const CNode * pNode);
+
+  /**
+   * Check whether the node ids differ from the PIDs of the original network
+   * @return bool haveOriginalPids
+   */
+  static bool HaveOriginalPids();
+
   /**
    * Default construnctor
    * @param const std::string & networkFile
@@ -99,14 +189,51 @@ public:
 
   void partition(const int & parts, const bool & save, const std::string & outputDirectory = "");
 
+  /**
+   * Partition the network such that the number of edges between parts is minimal while the number of
+   * edges per part exceeds the average by at most maxImbalance. The nodes are relabeled so that each
+   * part is a contiguous range of ids and the relabeling is written to the file <network>.pidmap.
+   * If reorder is true the nodes within each part are ordered by reverse Cuthill-McKee.
+   * @param const int & parts
+   * @param const double & maxImbalance
+   * @param const bool & reorder
+   * @param const std::string & outputDirectory
+   */
+  void partitionMinimumCut(const int & parts, const double & maxImbalance, const bool & reorder, const std::string & outputDirectory);
+
   virtual void fromJSON(const json_t * json) override;
 
   const bool & isValid() const;
 
   CNode * lookupNode(const size_t & id, const bool localOnly) const;
 
+  /**
+   * Retrieve the node with the given PID of the original network, e.g., a PID from the person trait DB
+   * @param const size_t & pid
+   * @param const bool localOnly
+   * @return CNode * pNode (NULL if the node is not known)
+   */
+  CNode * lookupOriginalPid(const size_t & pid, const bool localOnly) const;
+
+  /**
+   * Retrieve the first edge from the source to the target in the order of the secondary edge index,
+   * i.e., by source id, target activity, source activity, and location id
+   * @param const size_t & targetId
+   * @param const size_t & sourceId
+   * @return CEdge * pEdge (NULL if no edge exists)
+   */
   CEdge * lookupEdge(const size_t & targetId, const size_t & sourceId) const;
 
+  /**
+   * Retrieve the edge identified by its target and its position within the edges of the target.
+   * If the position does not match the source the first edge from the source to the target is returned.
+   * @param const size_t & targetId
+   * @param const size_t & sourceId
+   * @param const size_t & offset
+   * @return CEdge * pEdge (NULL if no edge exists)
+   */
+  CEdge * lookupEdge(const size_t & targetId, const size_t & sourceId, const size_t & offset) const;
+
   CNode * beginNode();
 
   CNode * endNode();
@@ -115,26 +242,63 @@ public:
 
   CEdge * endEdge();
 
-  const std::map< size_t, CNode * > & getRemoteNodes() const;
+  const std::vector< std::pair< size_t, CNode * > > & getRemoteNodes() const;
   
-  std::map< size_t, CNode * >::const_iterator beginRemoteNodes() const;
+  std::vector< std::pair< size_t, CNode * > >::const_iterator beginRemoteNodes() const;
   
-  std::map< size_t, CNode * >::const_iterator endRemoteNodes() const;
+  std::vector< std::pair< size_t, CNode * > >::const_iterator endRemoteNodes() const;
   
   bool isRemoteNode(const CNode * pNode) const;
 
   bool isRemoteNode(const size_t & id) const;
 
+  /**
+   * Collect the changes of the local nodes and post them to all ranks requesting them if the
+   * node exchange is non blocking. This must be followed by broadcastChanges.
+   * @return int result
+   */
+  int beginBroadcastChanges();
+
   int broadcastChanges();
 
   CCommunicate::ErrorCode receiveNodes(std::istream & is, int sender);
 
+  /**
+   * Receive the changed nodes in the compact encoding written by CChanges::sendNodesRequested
+   * @param const char * pData
+   * @param const size_t & size
+   * @param const std::vector< CNode * > & remoteNodes the nodes identified by the indexes of the sender
+   * @param int sender
+   * @return CCommunicate::ErrorCode result
+   */
+  static CCommunicate::ErrorCode receiveCompactNodes(const char * pData, const size_t & size, const std::vector< CNode * > & remoteNodes, int sender);
+
   const size_t & getLocalNodeCount() const;
   const size_t & getGlobalNodeCount() const;
   const size_t & getLocalEdgeCount() const;
 
   bool haveValidPartition(const int & parts);
 
+  /**
+   * Retrieve the mirrored node data which is only available from the master
+   * @return const sNodeMirror * pNodeMirror (NULL if the mirror is not enabled)
+   */
+  const sNodeMirror * getNodeMirror() const;
+
+  /**
+   * Retrieve the mirrored data of the edges
+   * @return const sEdgeMirror & edgeMirror
+   */
+  const sEdgeMirror & getEdgeMirror() const;
+
+  /**
+   * Retrieve the local nodes of the thread which have at least one infectious source
+   * ordered by their position in the network. Must not be called while the frontier
+   * is updated.
+   * @return const std::vector< CNode * > & frontier
+   */
+  const std::vector< CNode * > & getFrontier();
+
 
   CCommunicate::ErrorCode receiveDump(std::istream & is, int sender);
   
@@ -142,7 +306,19 @@ public:
 
 private:
   void initExternalEdges();
+  void initNodeIndex();
+  void initEdgeIndex();
   void initOutgoingEdges();
+  void initMirror();
+  void initFrontier();
+  void initOriginalPids();
+  static CCommunicate::ErrorCode sendOriginalPidRequests(std::ostream & os, int receiver);
+  static CCommunicate::ErrorCode receiveOriginalPidRequests(std::istream & is, int sender);
+  static CCommunicate::ErrorCode sendOriginalPids(std::ostream & os, int receiver);
+  static CCommunicate::ErrorCode receiveOriginalPids(std::istream & is, int sender);
+  static void CompactRemoteNodes(std::vector< std::pair< size_t, CNode * > > & remoteNodes);
+  static const char * receiveData(std::istream & is, const size_t & size, std::string & copy);
+  size_t nodeIndex(const CNode * pNode) const;
   
   std::string mFile;
   CNode * mLocalNodes;
@@ -151,10 +327,21 @@ private:
   size_t mLocalNodesSize;
   CNode * mExternalNodes;
   size_t mExternalNodesSize;
-  std::map< size_t, CNode *> mRemoteNodes;
+  // The remote nodes sorted by id
+  std::vector< std::pair< size_t, CNode * > > mRemoteNodes;
+  // The id to node mapping of the rank, which is only available from the master
+  CNodeIndex mNodeIndex;
   std::set< size_t > mSourceOnlyNodes;
   CEdge * mEdges;
   size_t mEdgesSize;
+  std::vector< sEdgeNodes > mEdgeNodes;
+  // The positions of the edges of each target sorted by source, aligned with mEdges
+  std::vector< unsigned int > mEdgesBySource;
+  // The outgoing edges of all sources grouped by source, referenced by CNode::OutgoingEdges
+  std::vector< CEdge * > mOutgoingEdges;
+  size_t mEdgeOffset;
+  char * mpEdgeMap;
+  size_t mEdgeMapSize;
   size_t mTotalNodesSize;
   size_t mTotalEdgesSize;
   size_t mSizeOfPid;
@@ -166,6 +353,27 @@ private:
 
   dump_active_network mDumpActiveNetwork;
 
+  // Per thread buffers used when parsing text networks.
+  mutable std::string mLine;
+  mutable std::string mKey;
+  mutable trait_cache mActivityCache;
+  mutable trait_cache mEdgeTraitCache;
+
+  sNodeMirror * mpNodeMirror;
+  sEdgeMirror mEdgeMirror;
+
+  // One bit per local node of the thread which is set when the node gains an infectious source
+  std::vector< size_t > mFrontierBits;
+  std::vector< CNode * > mFrontier;
+  bool mHaveFrontier;
+
+  // The PIDs of the original network of relabeled partitions. The master holds them for all nodes
+  // indexed by nodeIndex, each thread holds those of its partition while loading.
+  std::vector< size_t > mOriginalPids;
+  std::unordered_map< size_t, CNode * > mNodesByOriginalPid;
+  // The ids and original PIDs of the local nodes requested by other ranks
+  std::map< int, std::vector< size_t > > mOriginalPidReplies;
+  bool mHaveOriginalPids;
 };
 
 #endif /* SRC_NETWORK_CNETWORK_H_ */
@@ -32,6 +32,7 @@
 #include "traits/CTrait.h"
 #include "utilities/CMetadata.h"
 #include "utilities/CLogger.h"
+#include "utilities/CStreamBuffer.h"
 
 // static
 CNode CNode::getDefault()
@@ -56,6 +57,9 @@ CNode::CNode()
   , infectivity(0.0)
   , nodeTrait()
   , changed(false)
+  , changedFields(0)
+  , infectiousSources(0)
+  , isInfectious(false)
   , Edges(NULL)
   , EdgesSize(0)
   , OutgoingEdges()
@@ -86,6 +90,9 @@ CNode::CNode(const CNode & src)
   , infectivity(src.infectivity)
   , nodeTrait(src.nodeTrait)
   , changed(src.changed)
+  , changedFields(src.changedFields)
+  , infectiousSources(0)
+  , isInfectious(false)
   , Edges(src.Edges)
   , EdgesSize(src.EdgesSize)
   , OutgoingEdges()
@@ -113,18 +120,7 @@ CNode::CNode(const CNode & src)
 
 CNode::~CNode()
 {
-  if (OutgoingEdges.Master().pEdges != NULL)
-    {
-      delete [] OutgoingEdges.Master().pEdges;
-    }
-
-  sOutgoingEdges * pIt = OutgoingEdges.beginThread();
-  sOutgoingEdges * pEnd = OutgoingEdges.endThread();
-
-  for (; pIt != pEnd; ++pIt)
-    if (OutgoingEdges.isThread(pIt)  
-        && pIt->pEdges != NULL)
-      delete [] pIt->pEdges;
+  // The outgoing edges are owned by the network.
 }
 
 CNode & CNode::operator = (const CNode & rhs)
@@ -147,9 +143,15 @@ CNode & CNode::operator = (const CNode & rhs)
   return *this;
 }
 
+// The binary data span the fields from id through nodeTrait including the padding to the alignment of the node.
+const size_t CNode::BinarySize = 56;
+
+static_assert(CNode::BinarySize == (sizeof(size_t) + sizeof(CModel::state_t) + 4 * sizeof(double) + sizeof(CTraitData::base) + alignof(CNode) - 1) / alignof(CNode) * alignof(CNode),
+              "CNode::BinarySize does not match the binary data");
+
 void CNode::toBinary(std::ostream & os) const
 {
-  os.write(reinterpret_cast<const char *>(&id), 56);
+  os.write(reinterpret_cast<const char *>(&id), BinarySize);
 
   /*
   os.write(reinterpret_cast<const char *>(&id), sizeof(size_t));
@@ -164,12 +166,12 @@ void CNode::toBinary(std::ostream & os) const
 
 void CNode::fromBinary(std::istream & is)
 {
-  is.read(reinterpret_cast<char *>(&id), 56);
+  is.read(reinterpret_cast<char *>(&id), BinarySize);
 
   size_t read = is.gcount(); 
   
   if (read != 0
-      && read != 56)
+      && read != BinarySize)
     {
       CLogger::error("CNode: fromBinary read '{}'.", read); 
     }
@@ -185,6 +187,80 @@ void CNode::fromBinary(std::istream & is)
   */
 
   pHealthState = CModel::StateFromType(healthState);
+  CNetwork::MirrorNode(this);
+  CNetwork::UpdateFrontier(this);
+}
+
+void CNode::toCompactBinary(std::ostream & os) const
+{
+  os.put(static_cast< char >(changedFields));
+
+  if (changedFields & HealthStateField)
+    CStreamBuffer::writeVarint(os, healthState);
+
+  if (changedFields & SusceptibilityFactorField)
+    os.write(reinterpret_cast< const char * >(&susceptibilityFactor), sizeof(double));
+
+  if (changedFields & SusceptibilityField)
+    os.write(reinterpret_cast< const char * >(&susceptibility), sizeof(double));
+
+  if (changedFields & InfectivityFactorField)
+    os.write(reinterpret_cast< const char * >(&infectivityFactor), sizeof(double));
+
+  if (changedFields & InfectivityField)
+    os.write(reinterpret_cast< const char * >(&infectivity), sizeof(double));
+
+  if (changedFields & NodeTraitField)
+    os.write(reinterpret_cast< const char * >(&nodeTrait), sizeof(CTraitData::base));
+}
+
+unsigned char CNode::fromCompactBinary(std::istream & is)
+{
+  unsigned char Fields = static_cast< unsigned char >(is.get());
+
+  if (Fields & HealthStateField)
+    CStreamBuffer::readVarint(is, healthState);
+
+  if (Fields & SusceptibilityFactorField)
+    is.read(reinterpret_cast< char * >(&susceptibilityFactor), sizeof(double));
+
+  if (Fields & SusceptibilityField)
+    is.read(reinterpret_cast< char * >(&susceptibility), sizeof(double));
+
+  if (Fields & InfectivityFactorField)
+    is.read(reinterpret_cast< char * >(&infectivityFactor), sizeof(double));
+
+  if (Fields & InfectivityField)
+    is.read(reinterpret_cast< char * >(&infectivity), sizeof(double));
+
+  if (Fields & NodeTraitField)
+    is.read(reinterpret_cast< char * >(&nodeTrait), sizeof(CTraitData::base));
+
+  if (is.fail())
+    {
+      CLogger::error("CNode: fromCompactBinary failed.");
+      return 0;
+    }
+
+  return Fields;
+}
+
+void CNode::recordChangedFields(const double & oldSusceptibilityFactor,
+                                const double & oldSusceptibility,
+                                const double & oldInfectivityFactor,
+                                const double & oldInfectivity)
+{
+  if (susceptibilityFactor != oldSusceptibilityFactor)
+    changedFields |= SusceptibilityFactorField;
+
+  if (susceptibility != oldSusceptibility)
+    changedFields |= SusceptibilityField;
+
+  if (infectivityFactor != oldInfectivityFactor)
+    changedFields |= InfectivityFactorField;
+
+  if (infectivity != oldInfectivity)
+    changedFields |= InfectivityField;
 }
 
 bool CNode::set(const CTransmission * pTransmission, const CMetadata & ENABLE_TRACE(metadata))
@@ -200,12 +276,20 @@ bool CNode::set(const CTransmission * pTransmission, const CMetadata & ENABLE_TR
                      id, pTransmission->getExitState()->getId(), (size_t) metadata.getInt("ContactNode"));
   );
 
+  double SusceptibilityFactor = susceptibilityFactor;
+  double Susceptibility = susceptibility;
+  double InfectivityFactor = infectivityFactor;
+  double Infectivity = infectivity;
+
   setHealthState(pTransmission->getExitState());
 
   pTransmission->updateSusceptibilityFactor(susceptibilityFactor);
   susceptibility = pHealthState->getSusceptibility() * susceptibilityFactor;
   pTransmission->updateInfectivityFactor(infectivityFactor);
   infectivity = pHealthState->getInfectivity() * infectivityFactor;
+  recordChangedFields(SusceptibilityFactor, Susceptibility, InfectivityFactor, Infectivity);
+  CNetwork::MirrorNode(this);
+  CNetwork::UpdateFrontier(this);
 
   // std::cout << id << "," << pTransmission->getEntryState() << "," << pTransmission->getExitState() << "," << pTransmission->getContactState() << std::endl;
 
@@ -220,12 +304,20 @@ bool CNode::set(const CProgression * pProgression, const CMetadata & /* metadata
 
   ENABLE_TRACE(CLogger::trace("CNode [Progression]: Node ({}) healthState = {}", id, pProgression->getExitState()->getId()););
   
+  double SusceptibilityFactor = susceptibilityFactor;
+  double Susceptibility = susceptibility;
+  double InfectivityFactor = infectivityFactor;
+  double Infectivity = infectivity;
+
   setHealthState(pProgression->getExitState());
 
   pProgression->updateSusceptibilityFactor(susceptibilityFactor);
   susceptibility = pHealthState->getSusceptibility() * susceptibilityFactor;
   pProgression->updateInfectivityFactor(infectivityFactor);
   infectivity = pHealthState->getInfectivity() * infectivityFactor;
+  recordChangedFields(SusceptibilityFactor, Susceptibility, InfectivityFactor, Infectivity);
+  CNetwork::MirrorNode(this);
+  CNetwork::UpdateFrontier(this);
 
   // std::cout << id << "," << pProgression->getEntryState() << "," << pProgression->getExitState() << std::endl;
 
@@ -241,8 +333,14 @@ bool CNode::setSusceptibilityFactor(const double & value, CValueInterface::pOper
                               id,
                               CValueInterface::operatorToString(pOperator),
                               value););
+  double SusceptibilityFactor = susceptibilityFactor;
+  double Susceptibility = susceptibility;
+  double InfectivityFactor = infectivityFactor;
+  double Infectivity = infectivity;
+
   (*pOperator)(susceptibilityFactor, value);
   susceptibility = pHealthState->getSusceptibility() * susceptibilityFactor;
+  recordChangedFields(SusceptibilityFactor, Susceptibility, InfectivityFactor, Infectivity);
 
   return true;
 }
@@ -254,8 +352,16 @@ bool CNode::setInfectivityFactor(const double &  value, CValueInterface::pOperat
                               id,
                               CValueInterface::operatorToString(pOperator),
                               value););
+  double SusceptibilityFactor = susceptibilityFactor;
+  double Susceptibility = susceptibility;
+  double InfectivityFactor = infectivityFactor;
+  double Infectivity = infectivity;
+
   (*pOperator)(infectivityFactor, value);
   infectivity = pHealthState->getInfectivity() * infectivityFactor;
+  recordChangedFields(SusceptibilityFactor, Susceptibility, InfectivityFactor, Infectivity);
+  CNetwork::MirrorNode(this);
+  CNetwork::UpdateFrontier(this);
 
   return true;
 }
@@ -267,10 +373,18 @@ bool CNode::setHealthState(const CModel::state_t & value, CValueInterface::pOper
                               id,
                               CValueInterface::operatorToString(pOperator),
                               CModel::StateFromType(value)->getId()););
+  double SusceptibilityFactor = susceptibilityFactor;
+  double Susceptibility = susceptibility;
+  double InfectivityFactor = infectivityFactor;
+  double Infectivity = infectivity;
+
   setHealthState(CModel::StateFromType(value));
 
   susceptibility = pHealthState->getSusceptibility() * susceptibilityFactor;
   infectivity = pHealthState->getInfectivity() * infectivityFactor;
+  recordChangedFields(SusceptibilityFactor, Susceptibility, InfectivityFactor, Infectivity);
+  CNetwork::MirrorNode(this);
+  CNetwork::UpdateFrontier(this);
 
   CModel::StateChanged(this);
 
@@ -284,8 +398,12 @@ bool CNode::setNodeTrait(const CTraitData::value & value, CValueInterface::pOper
                               id,
                               CValueInterface::operatorToString(pOperator),
                               CTrait::NodeTrait->toString(value)););
+  CTraitData::base NodeTrait = nodeTrait;
   CTraitData::setValue(nodeTrait, value);
 
+  if (nodeTrait != NodeTrait)
+    changedFields |= NodeTraitField;
+
   return true;
 }
 
@@ -295,18 +413,25 @@ void CNode::setHealthState(const CHealthState * pNewHealthState)
     {
       pHealthState = pNewHealthState;
       healthState = pHealthState->getIndex();
+      CNetwork::MirrorNode(this);
+      CNetwork::UpdateFrontier(this);
       return;
     }
 
   if (pHealthState != NULL)
     pHealthState->decrement();
 
+  if (pHealthState != pNewHealthState)
+    changedFields |= HealthStateField;
+
   pHealthState = pNewHealthState;
 
   if (pHealthState != NULL)
     pHealthState->increment();
 
   healthState = pHealthState->getIndex();
+  CNetwork::MirrorNode(this);
+  CNetwork::UpdateFrontier(this);
 }
 
 
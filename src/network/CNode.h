@@ -54,6 +54,11 @@ public:
     size_t Size;
   };
 
+  /**
+   * The size of the data written by toBinary
+   */
+  static const size_t BinarySize;
+
   static CNode getDefault();
 
   CNode();
@@ -63,9 +68,37 @@ public:
 
   CNode & operator = (const CNode & rhs);
 
+  /**
+   * Bits identifying the fields of the binary data which changed since the last exchange
+   */
+  enum ChangedField : unsigned char
+  {
+    HealthStateField = 0x01,
+    SusceptibilityFactorField = 0x02,
+    SusceptibilityField = 0x04,
+    InfectivityFactorField = 0x08,
+    InfectivityField = 0x10,
+    NodeTraitField = 0x20,
+    AllFields = 0x3f
+  };
+
   void toBinary(std::ostream & os) const;
   void fromBinary(std::istream & is);
 
+  /**
+   * Write the bitmask of the changed fields followed by the changed fields
+   * @param std::ostream & os
+   */
+  void toCompactBinary(std::ostream & os) const;
+
+  /**
+   * Read the data written by toCompactBinary. Only the fields which are included are
+   * updated.
+   * @param std::istream & is
+   * @return unsigned char fields (0 on failure)
+   */
+  unsigned char fromCompactBinary(std::istream & is);
+
   bool set(const CTransmission * pTransmission, const CMetadata & metadata);
   bool set(const CProgression * pProgression, const CMetadata & metadata);
   bool setSusceptibilityFactor(const double & value, CValueInterface::pOperator pOperator, const CMetadata & metadata);
@@ -87,11 +120,22 @@ public:
   // end binary data
 
   mutable bool changed;
+  mutable unsigned char changedFields;
+
+  // Transmission frontier maintained by CNetwork::UpdateFrontier
+  int infectiousSources;
+  bool isInfectious;
+
   CEdge * Edges;
   size_t EdgesSize;
   CContext< sOutgoingEdges > OutgoingEdges;
 
 private:
+  void recordChangedFields(const double & oldSusceptibilityFactor,
+                           const double & oldSusceptibility,
+                           const double & oldInfectivityFactor,
+                           const double & oldInfectivity);
+
   const CHealthState * pHealthState;
 };
 
@@ -0,0 +1,130 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include "network/CNodeIndex.h"
+#include "network/CNode.h"
+#include "utilities/CLogger.h"
+
+// static
+const size_t CNodeIndex::Empty = std::numeric_limits< size_t >::max();
+
+// static
+const size_t CNodeIndex::MaxSparsity = 4;
+
+CNodeIndex::CNodeIndex()
+  : mFirstId(0)
+  , mDirect()
+  , mKeys()
+  , mValues()
+  , mMask(0)
+  , mShift(64)
+  , mValid(false)
+{}
+
+CNodeIndex::~CNodeIndex()
+{}
+
+void CNodeIndex::init(CNode * pBegin, CNode * pEnd, const std::vector< std::pair< size_t, CNode * > > & remoteNodes)
+{
+  clear();
+
+  // Unused trailing nodes have the default id.
+  while (pEnd > pBegin && (pEnd - 1)->id == Empty)
+    --pEnd;
+
+  size_t LocalNodes = pEnd - pBegin;
+  size_t HashedNodes = remoteNodes.size();
+  bool Direct = LocalNodes > 0
+                && (pEnd - 1)->id - pBegin->id < MaxSparsity * LocalNodes;
+
+  if (Direct)
+    {
+      mFirstId = pBegin->id;
+      mDirect.resize((pEnd - 1)->id - mFirstId + 1, NULL);
+
+      for (CNode * pNode = pBegin; pNode != pEnd; ++pNode)
+        mDirect[pNode->id - mFirstId] = pNode;
+    }
+  else
+    {
+      HashedNodes += LocalNodes;
+    }
+
+  if (HashedNodes > 0)
+    {
+      size_t Capacity = 2;
+      mShift = 63;
+
+      while (Capacity < 2 * HashedNodes)
+        {
+          Capacity <<= 1;
+          --mShift;
+        }
+
+      mMask = Capacity - 1;
+      mKeys.resize(Capacity, Empty);
+      mValues.resize(Capacity, NULL);
+
+      if (!Direct)
+        for (CNode * pNode = pBegin; pNode != pEnd; ++pNode)
+          insert(pNode->id, pNode);
+
+      std::vector< std::pair< size_t, CNode * > >::const_iterator it = remoteNodes.begin();
+      std::vector< std::pair< size_t, CNode * > >::const_iterator end = remoteNodes.end();
+
+      for (; it != end; ++it)
+        insert(it->first, it->second);
+    }
+
+  mValid = true;
+
+  CLogger::info("CNodeIndex: direct '{}', hashed '{}' ({} bytes).", mDirect.size(), HashedNodes, mDirect.size() * sizeof(CNode *) + mKeys.size() * (sizeof(size_t) + sizeof(CNode *)));
+}
+
+void CNodeIndex::clear()
+{
+  mFirstId = 0;
+  mDirect.clear();
+  mKeys.clear();
+  mValues.clear();
+  mMask = 0;
+  mShift = 64;
+  mValid = false;
+}
+
+const bool & CNodeIndex::isValid() const
+{
+  return mValid;
+}
+
+void CNodeIndex::insert(const size_t & id, CNode * pNode)
+{
+  size_t Slot = hash(id);
+
+  while (mKeys[Slot] != Empty && mKeys[Slot] != id)
+    Slot = (Slot + 1) & mMask;
+
+  mKeys[Slot] = id;
+  mValues[Slot] = pNode;
+}
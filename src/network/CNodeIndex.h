@@ -0,0 +1,114 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_NETWORK_CNODEINDEX_H_
+#define SRC_NETWORK_CNODEINDEX_H_
+
+#include <utility>
+#include <vector>
+#include <limits>
+#include <cstddef>
+
+class CNode;
+
+/**
+ * An O(1) mapping from node id to the nodes known to a rank, i.e., its local and remote nodes.
+ *
+ * The local nodes of a rank cover a contiguous range of ids. If this range is dense the nodes
+ * are found by direct addressing. All other nodes are stored in an open addressing hash table
+ * with linear probing which is at most half full.
+ */
+class CNodeIndex
+{
+public:
+  CNodeIndex();
+
+  ~CNodeIndex();
+
+  /**
+   * Build the index for the local nodes sorted by id and the remote nodes.
+   * @param CNode * pBegin
+   * @param CNode * pEnd
+   * @param const std::vector< std::pair< size_t, CNode * > > & remoteNodes
+   */
+  void init(CNode * pBegin, CNode * pEnd, const std::vector< std::pair< size_t, CNode * > > & remoteNodes);
+
+  void clear();
+
+  const bool & isValid() const;
+
+  /**
+   * Retrieve the node with the given id
+   * @param const size_t & id
+   * @return CNode * pNode (NULL if the node is not known)
+   */
+  inline CNode * lookup(const size_t & id) const
+  {
+    // Ids below mFirstId wrap around and are handled by the hash table.
+    if (id - mFirstId < mDirect.size())
+      return mDirect[id - mFirstId];
+
+    if (mKeys.empty())
+      return NULL;
+
+    size_t Slot = hash(id);
+
+    while (true)
+      {
+        if (mKeys[Slot] == id)
+          return mValues[Slot];
+
+        if (mKeys[Slot] == Empty)
+          return NULL;
+
+        Slot = (Slot + 1) & mMask;
+      }
+
+    return NULL;
+  }
+
+private:
+  static const size_t Empty;
+
+  // The maximal ratio of the id range and the number of local nodes for direct addressing.
+  static const size_t MaxSparsity;
+
+  inline size_t hash(const size_t & id) const
+  {
+    // Fibonacci hashing
+    return (id * 11400714819323198485ull) >> mShift;
+  }
+
+  void insert(const size_t & id, CNode * pNode);
+
+  size_t mFirstId;
+  std::vector< CNode * > mDirect;
+  std::vector< size_t > mKeys;
+  std::vector< CNode * > mValues;
+  size_t mMask;
+  int mShift;
+  bool mValid;
+};
+
+#endif /* SRC_NETWORK_CNODEINDEX_H_ */
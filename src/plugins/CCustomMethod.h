@@ -50,6 +50,8 @@ public:
 
   void setCustomMethod(custom_type pCustomMethod) const;
 
+  bool hasCustomMethod() const;
+
 protected:
   custom_type mpDefaultMethod;
   mutable custom_type mpCustomMethod;
@@ -61,6 +63,12 @@ CCustomMethod< custom_type >::CCustomMethod(custom_type pDefaultMethod)
   , mpCustomMethod(pDefaultMethod)
 {}
 
+template < class custom_type >
+bool CCustomMethod< custom_type >::hasCustomMethod() const
+{
+  return mpCustomMethod != mpDefaultMethod;
+}
+
 template < class custom_type >
 void CCustomMethod< custom_type >::setCustomMethod(custom_type pCustomMethod) const
 {
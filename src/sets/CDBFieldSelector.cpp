@@ -31,6 +31,7 @@
 #include "db/CQuery.h"
 #include "db/CFieldValue.h"
 #include "db/CFieldValueList.h"
+#include "network/CNetwork.h"
 #include "network/CNode.h"
 #include "utilities/CLogger.h"
 
@@ -202,7 +203,7 @@ bool CDBFieldSelector::computeProtected()
 
   for (; itConstraint != endConstraint; ++itConstraint)
     {
-      ConstraintValueList.append(CFieldValue((*itConstraint)->id));
+      ConstraintValueList.append(CFieldValue(CNetwork::OriginalPid(*itConstraint)));
     }
 
   bool success = CQuery::in(mTable, mField, FieldValueList, false, "pid", ConstraintValueList);
@@ -34,6 +34,7 @@
 #include "db/CFieldValue.h"
 #include "db/CFieldValueList.h"
 #include "db/CQuery.h"
+#include "db/CQueryCache.h"
 #include "db/CSchema.h"
 #include "network/CNetwork.h"
 #include "network/CNode.h"
@@ -957,8 +958,8 @@ bool CNodeElementSelector::propertySelection()
   if (!mLocalScope)
     {
       CLogger::debug("CNodeElementSelector: Processing remote nodes");
-      std::map< size_t, CNode * >::const_iterator it = CNetwork::Context.Active().beginRemoteNodes();
-      std::map< size_t, CNode * >::const_iterator end = CNetwork::Context.Active().endRemoteNodes();
+      std::vector< std::pair< size_t, CNode * > >::const_iterator it = CNetwork::Context.Active().beginRemoteNodes();
+      std::vector< std::pair< size_t, CNode * > >::const_iterator end = CNetwork::Context.Active().endRemoteNodes();
       bool sort = false;
 
       for (; it != end; ++it)
@@ -1000,8 +1001,8 @@ bool CNodeElementSelector::propertyIn()
     {
       CLogger::debug("CNodeElementSelector: Processing remote nodes");
 
-      std::map< size_t, CNode * >::const_iterator it = CNetwork::Context.Active().beginRemoteNodes();
-      std::map< size_t, CNode * >::const_iterator end = CNetwork::Context.Active().endRemoteNodes();
+      std::vector< std::pair< size_t, CNode * > >::const_iterator it = CNetwork::Context.Active().beginRemoteNodes();
+      std::vector< std::pair< size_t, CNode * > >::const_iterator end = CNetwork::Context.Active().endRemoteNodes();
       bool sort = false;
 
       for (; it != end; ++it)
@@ -1042,8 +1043,8 @@ bool CNodeElementSelector::propertyNotIn()
     {
       CLogger::debug("CNodeElementSelector: Processing remote nodes");
 
-      std::map< size_t, CNode * >::const_iterator it = CNetwork::Context.Active().beginRemoteNodes();
-      std::map< size_t, CNode * >::const_iterator end = CNetwork::Context.Active().endRemoteNodes();
+      std::vector< std::pair< size_t, CNode * > >::const_iterator it = CNetwork::Context.Active().beginRemoteNodes();
+      std::vector< std::pair< size_t, CNode * > >::const_iterator end = CNetwork::Context.Active().endRemoteNodes();
       bool sort = false;
 
       for (; it != end; ++it)
@@ -1077,9 +1078,9 @@ bool CNodeElementSelector::withIncomingEdge()
   std::vector< CEdge * >::const_iterator end = mpSelector->endEdges();
 
   for (; it != end; ++it)
-    if ((*it)->pTarget != pNode)
+    if ((*it)->target() != pNode)
       {
-        pNode = (*it)->pTarget;
+        pNode = (*it)->target();
         Nodes.push_back(pNode);
       }
 
@@ -1094,6 +1095,11 @@ bool CNodeElementSelector::dbAll()
   std::vector< CNode * > & Nodes = getNodes();
   Nodes.clear();
 
+  CQueryCache::Key Key(mDBTable, "", "all", mLocalScope);
+
+  if (CQueryCache::lookup(Key, Nodes))
+    return true;
+
   CFieldValueList FieldValueList;
   bool success = CQuery::all(mDBTable, "pid", FieldValueList, mLocalScope);
 
@@ -1103,13 +1109,16 @@ bool CNodeElementSelector::dbAll()
 
   for (; it != end; ++it)
     {
-      if ((pNode = CNetwork::Context.Active().lookupNode(it->toId(), mLocalScope)) != NULL)
+      if ((pNode = CNetwork::Context.Active().lookupOriginalPid(it->toId(), mLocalScope)) != NULL)
         Nodes.push_back(pNode);
     }
 
   if (!mLocalScope)
     std::sort(Nodes.begin(), Nodes.end());
 
+  if (success)
+    CQueryCache::insert(Key, Nodes);
+
   CLogger::debug("CNodeElementSelector: dbAll returned '{}' nodes.", Nodes.size());
   return success;
 }
@@ -1121,13 +1130,13 @@ bool CNodeElementSelector::dbSelection()
   Nodes.clear();
 
   CFieldValueList FieldValueList;
+  CValueInterface Constraint = mpObservable ? CValueInterface(*mpObservable) : (mpVariable ? mpVariable->toValue() : CValueInterface(*mpDBFieldValue));
+  CQueryCache::Key Key(mDBTable, mDBField, mSQLComparison, mLocalScope, Constraint);
 
-  if (mpObservable)
-    success = CQuery::where(mDBTable, "pid", FieldValueList, mLocalScope, mDBField, *mpObservable, mSQLComparison);
-  else if (mpVariable)
-    success = CQuery::where(mDBTable, "pid", FieldValueList, mLocalScope, mDBField, mpVariable->toValue(), mSQLComparison);
-  else
-    success = CQuery::where(mDBTable, "pid", FieldValueList, mLocalScope, mDBField, *mpDBFieldValue, mSQLComparison);
+  if (CQueryCache::lookup(Key, Nodes))
+    return true;
+
+  success = CQuery::where(mDBTable, "pid", FieldValueList, mLocalScope, mDBField, Constraint, mSQLComparison);
 
   CFieldValueList::const_iterator it = FieldValueList.begin();
   CFieldValueList::const_iterator end = FieldValueList.end();
@@ -1135,13 +1144,16 @@ bool CNodeElementSelector::dbSelection()
 
   for (; it != end; ++it)
     {
-      if ((pNode = CNetwork::Context.Active().lookupNode(it->toId(), mLocalScope)) != NULL)
+      if ((pNode = CNetwork::Context.Active().lookupOriginalPid(it->toId(), mLocalScope)) != NULL)
         Nodes.push_back(pNode);
     }
 
   if (!mLocalScope)
     std::sort(Nodes.begin(), Nodes.end());
 
+  if (success)
+    CQueryCache::insert(Key, Nodes);
+
   CLogger::debug("CNodeElementSelector: dbSelection returned '{}' nodes.", Nodes.size());
   return success;
 }
@@ -1153,32 +1165,43 @@ bool CNodeElementSelector::dbIn()
   Nodes.clear();
 
   CFieldValueList FieldValueList;
+  const CValueList * pConstraints = mpDBFieldValueList;
 
-  if (mpDBFieldValueList != NULL)
-    success = CQuery::in(mDBTable, "pid", FieldValueList, mLocalScope, mDBField, *mpDBFieldValueList);
-  else
+  if (pConstraints == NULL)
     {
       CField Field = CSchema::INSTANCE.getTable(mDBTable).getField(mDBField);
       const CDBFieldValues & ValueListMap = mpSelector->getDBFieldValues();
       CDBFieldValues::const_iterator found = ValueListMap.find(Field.getType());
 
-      if (found != ValueListMap.end())
-        success = CQuery::in(mDBTable, "pid", FieldValueList, mLocalScope, mDBField, found->second);
+      if (found == ValueListMap.end())
+        return false;
+
+      pConstraints = &found->second;
     }
 
+  CQueryCache::Key Key(mDBTable, mDBField, "in", mLocalScope, *pConstraints);
+
+  if (CQueryCache::lookup(Key, Nodes))
+    return true;
+
+  success = CQuery::in(mDBTable, "pid", FieldValueList, mLocalScope, mDBField, *pConstraints);
+
   CFieldValueList::const_iterator it = FieldValueList.begin();
   CFieldValueList::const_iterator end = FieldValueList.end();
   CNode * pNode;
 
   for (; it != end; ++it)
     {
-      if ((pNode = CNetwork::Context.Active().lookupNode(it->toId(), mLocalScope)) != NULL)
+      if ((pNode = CNetwork::Context.Active().lookupOriginalPid(it->toId(), mLocalScope)) != NULL)
         Nodes.push_back(pNode);
     }
 
   if (!mLocalScope)
     std::sort(Nodes.begin(), Nodes.end());
 
+  if (success)
+    CQueryCache::insert(Key, Nodes);
+
   CLogger::debug("CNodeElementSelector: dbIn returned '{}' nodes.", Nodes.size());
   return success;
 }
@@ -1190,32 +1213,43 @@ bool CNodeElementSelector::dbNotIn()
   Nodes.clear();
 
   CFieldValueList FieldValueList;
+  const CValueList * pConstraints = mpDBFieldValueList;
 
-  if (mpDBFieldValueList != NULL)
-    success = CQuery::notIn(mDBTable, "pid", FieldValueList, mLocalScope, mDBField, *mpDBFieldValueList);
-  else
+  if (pConstraints == NULL)
     {
       CField Field = CSchema::INSTANCE.getTable(mDBTable).getField(mDBField);
       const CDBFieldValues & ValueListMap = mpSelector->getDBFieldValues();
       CDBFieldValues::const_iterator found = ValueListMap.find(Field.getType());
 
-      if (found != ValueListMap.end())
-        success = CQuery::notIn(mDBTable, "pid", FieldValueList, mLocalScope, mDBField, found->second);
+      if (found == ValueListMap.end())
+        return false;
+
+      pConstraints = &found->second;
     }
 
+  CQueryCache::Key Key(mDBTable, mDBField, "not in", mLocalScope, *pConstraints);
+
+  if (CQueryCache::lookup(Key, Nodes))
+    return true;
+
+  success = CQuery::notIn(mDBTable, "pid", FieldValueList, mLocalScope, mDBField, *pConstraints);
+
   CFieldValueList::const_iterator it = FieldValueList.begin();
   CFieldValueList::const_iterator end = FieldValueList.end();
   CNode * pNode;
 
   for (; it != end; ++it)
     {
-      if ((pNode = CNetwork::Context.Active().lookupNode(it->toId(), mLocalScope)) != NULL)
+      if ((pNode = CNetwork::Context.Active().lookupOriginalPid(it->toId(), mLocalScope)) != NULL)
         Nodes.push_back(pNode);
     }
 
   if (!mLocalScope)
     std::sort(Nodes.begin(), Nodes.end());
 
+  if (success)
+    CQueryCache::insert(Key, Nodes);
+
   CLogger::debug("CNodeElementSelector: dbNotIn returned '{}' nodes.", Nodes.size());
   return success;
 }
@@ -38,11 +38,14 @@ std::string CArgs::Name;
 //static 
 std::string CArgs::Path;
 
+bool CArgs::Restart(false);
+
 bool CArgs::parseArgs(int argc, char * argv[])
 {
   Config.clear();
   Path.clear();
   Name.clear();
+  Restart = false;
 
   if (argc == 0)
     return false; 
@@ -50,11 +53,12 @@ bool CArgs::parseArgs(int argc, char * argv[])
   Path = argv[0];
   Name = CDirEntry::fileName(Path);
 
-  const char * const short_opts = "c";
+  const char * const short_opts = "c:r";
 
   const option long_opts[] =
     {
       {"config", required_argument, nullptr, 'c'},
+      {"restart", no_argument, nullptr, 'r'},
       {nullptr, no_argument, nullptr, 0}
     };
 
@@ -71,6 +75,10 @@ bool CArgs::parseArgs(int argc, char * argv[])
           Config = std::string(optarg);
           break;
 
+        case 'r':
+          Restart = true;
+          break;
+
         case '?':
         default:
           return false;
@@ -84,7 +92,9 @@ void CArgs::printUsage()
 {
   std::cout << std::endl
             << "Usage:" << std::endl
-            << "  " << Name << " --config <configFilename>" << std::endl;
+            << "  " << Name << " --config <configFilename> [--restart]" << std::endl
+            << std::endl
+            << "  --restart  resume the simulation from the checkpoint specified in the configuration" << std::endl;
 }
 
 void CArgs::printWhoAmI()
@@ -136,3 +146,8 @@ const std::string & CArgs::getPath()
   return Path;
 }
 
+bool CArgs::isRestart()
+{
+  return Restart;
+}
+
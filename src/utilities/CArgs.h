@@ -42,8 +42,11 @@ public:
 
   static const std::string & getPath();
 
+  static bool isRestart();
+
 private:
   static std::string Config;
+  static bool Restart;
   static std::string Name;
   static std::string Path;
 };
@@ -0,0 +1,200 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+
+#include "utilities/CAsyncWriter.h"
+#include "utilities/CLogger.h"
+
+// static
+std::thread * CAsyncWriter::pThread(NULL);
+
+// static
+std::mutex CAsyncWriter::Mutex;
+
+// static
+std::condition_variable CAsyncWriter::Condition;
+
+// static
+std::deque< CAsyncWriter::sTask > CAsyncWriter::Queue;
+
+// static
+size_t CAsyncWriter::Capacity(1);
+
+// static
+bool CAsyncWriter::Busy(false);
+
+// static
+bool CAsyncWriter::Stop(false);
+
+// static
+std::vector< std::string > CAsyncWriter::Failed;
+
+// static
+void CAsyncWriter::start(size_t capacity)
+{
+  if (pThread != NULL)
+    return;
+
+  Capacity = std::max< size_t >(capacity, 1);
+  Stop = false;
+  pThread = new std::thread(&CAsyncWriter::run);
+}
+
+// static
+bool CAsyncWriter::stop()
+{
+  if (pThread == NULL)
+    return true;
+
+  bool success = flush();
+
+  {
+    std::lock_guard< std::mutex > Lock(Mutex);
+    Stop = true;
+  }
+
+  Condition.notify_all();
+  pThread->join();
+
+  delete pThread;
+  pThread = NULL;
+
+  return success;
+}
+
+// static
+bool CAsyncWriter::isRunning()
+{
+  return pThread != NULL;
+}
+
+// static
+bool CAsyncWriter::submit(const std::string & file, CAsyncWriter::Task task)
+{
+  if (pThread == NULL)
+    {
+      if (task())
+        return true;
+
+      CLogger::error("CAsyncWriter: Failed to write '{}'.", file);
+      return false;
+    }
+
+  std::unique_lock< std::mutex > Lock(Mutex);
+
+  // The queue is bounded so that the simulation can not run away from the output.
+  Condition.wait(Lock, []{ return Queue.size() < Capacity; });
+
+  Queue.push_back({file, task});
+  Lock.unlock();
+
+  Condition.notify_all();
+
+  return true;
+}
+
+// static
+bool CAsyncWriter::append(const std::string & file, std::string && data)
+{
+  std::shared_ptr< std::string > pData = std::make_shared< std::string >(std::move(data));
+
+  return submit(file, [file, pData]{ return writeFile(file, *pData, std::ios_base::app); });
+}
+
+// static
+bool CAsyncWriter::write(const std::string & file, std::string && data)
+{
+  std::shared_ptr< std::string > pData = std::make_shared< std::string >(std::move(data));
+
+  return submit(file, [file, pData]{ return writeFile(file, *pData, std::ios_base::trunc); });
+}
+
+// static
+bool CAsyncWriter::flush()
+{
+  std::vector< std::string > Errors;
+
+  {
+    std::unique_lock< std::mutex > Lock(Mutex);
+    Condition.wait(Lock, []{ return Queue.empty() && !Busy; });
+    Errors.swap(Failed);
+  }
+
+  std::vector< std::string >::const_iterator it = Errors.begin();
+  std::vector< std::string >::const_iterator end = Errors.end();
+
+  for (; it != end; ++it)
+    CLogger::error("CAsyncWriter: Failed to write '{}'.", *it);
+
+  return Errors.empty();
+}
+
+// static
+void CAsyncWriter::run()
+{
+  std::unique_lock< std::mutex > Lock(Mutex);
+
+  while (true)
+    {
+      Condition.wait(Lock, []{ return Stop || !Queue.empty(); });
+
+      if (Queue.empty())
+        break;
+
+      sTask Task = Queue.front();
+      Queue.pop_front();
+      Busy = true;
+
+      Lock.unlock();
+      Condition.notify_all();
+
+      bool success = Task.task();
+
+      Lock.lock();
+      Busy = false;
+
+      // Errors are logged by the caller of flush as the logger is not used outside of the simulation threads.
+      if (!success)
+        Failed.push_back(Task.file);
+
+      Condition.notify_all();
+    }
+}
+
+// static
+bool CAsyncWriter::writeFile(const std::string & file, const std::string & data, std::ios_base::openmode mode)
+{
+  std::ofstream out(file.c_str(), mode | std::ios_base::out | std::ios_base::binary);
+
+  if (out.fail())
+    return false;
+
+  out.write(data.c_str(), data.size());
+  out.close();
+
+  return !out.fail();
+}
@@ -0,0 +1,115 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_UTILITIES_CASYNCWRITER_H_
+#define SRC_UTILITIES_CASYNCWRITER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <ios>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * A background thread per rank which writes output handed off by the tick loop.
+ *
+ * Tasks are executed in the order of submission. The queue is bounded, i.e., submitting blocks
+ * while the queue is full. If the writer is not running tasks are executed immediately by the caller.
+ * Errors are reported by flush, which must be called before any output file is inspected
+ * or modified by other means.
+ */
+class CAsyncWriter
+{
+public:
+  typedef std::function< bool () > Task;
+
+  /**
+   * Start the background thread
+   * @param size_t capacity the maximal number of queued tasks
+   */
+  static void start(size_t capacity);
+
+  /**
+   * Complete all queued tasks and stop the background thread
+   * @return bool success
+   */
+  static bool stop();
+
+  static bool isRunning();
+
+  /**
+   * Submit a task
+   * @param const std::string & file the file the task writes, used for error reporting
+   * @param Task task
+   * @return bool success (always true if the task is queued)
+   */
+  static bool submit(const std::string & file, Task task);
+
+  /**
+   * Append the data to the file
+   * @param const std::string & file
+   * @param std::string && data
+   * @return bool success
+   */
+  static bool append(const std::string & file, std::string && data);
+
+  /**
+   * Replace the content of the file with the data
+   * @param const std::string & file
+   * @param std::string && data
+   * @return bool success
+   */
+  static bool write(const std::string & file, std::string && data);
+
+  /**
+   * Wait until all queued tasks are completed and report errors
+   * @return bool success
+   */
+  static bool flush();
+
+private:
+  static void run();
+
+  static bool writeFile(const std::string & file, const std::string & data, std::ios_base::openmode mode);
+
+  struct sTask
+  {
+    std::string file;
+    Task task;
+  };
+
+  static std::thread * pThread;
+  static std::mutex Mutex;
+  static std::condition_variable Condition;
+  static std::deque< sTask > Queue;
+  static size_t Capacity;
+  static bool Busy;
+  static bool Stop;
+  static std::vector< std::string > Failed;
+};
+
+#endif /* SRC_UTILITIES_CASYNCWRITER_H_ */
@@ -0,0 +1,644 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#include <cstdio>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <unistd.h>
+#include <jansson.h>
+
+#include "utilities/CCheckpoint.h"
+#include "utilities/CAsyncWriter.h"
+#include "utilities/CCommunicate.h"
+#include "utilities/CDirEntry.h"
+#include "utilities/CLogger.h"
+#include "utilities/CMetadata.h"
+#include "utilities/CRandom.h"
+#include "utilities/CSimConfig.h"
+#include "actions/CActionQueue.h"
+#include "actions/CChanges.h"
+#include "diseaseModel/CHealthState.h"
+#include "diseaseModel/CModel.h"
+#include "diseaseModel/CProgression.h"
+#include "diseaseModel/CTransmission.h"
+#include "network/CNetwork.h"
+#include "network/CNode.h"
+#include "variables/CVariableList.h"
+
+// static
+bool CCheckpoint::Restart(false);
+
+// static
+int CCheckpoint::Tick(std::numeric_limits< int >::min());
+
+// static
+int CCheckpoint::PreviousTick(std::numeric_limits< int >::min());
+
+// static
+size_t CCheckpoint::OutputSize(0);
+
+// static
+size_t CCheckpoint::SummaryOutputSize(0);
+
+// static
+size_t CCheckpoint::RankOutputSize(0);
+
+// static
+bool CCheckpoint::load()
+{
+  Restart = false;
+
+  const CSimConfig::checkpoint & Checkpoint = CSimConfig::getCheckpoint();
+
+  if (Checkpoint.output.empty())
+    {
+      CLogger::error("CCheckpoint: Restart requires the run parameter 'checkpoint'.");
+      return false;
+    }
+
+  json_t * pRoot = CSimConfig::loadJson(Checkpoint.output, JSON_DECODE_INT_AS_REAL);
+
+  if (pRoot == NULL)
+    {
+      CLogger::error("CCheckpoint: Failed to load checkpoint '{}'.", Checkpoint.output);
+      return false;
+    }
+
+  bool success = true;
+  json_t * pValue = json_object_get(pRoot, "tick");
+
+  if (json_is_real(pValue))
+    Tick = json_real_value(pValue);
+  else
+    success = false;
+
+  pValue = json_object_get(pRoot, "numberOfParts");
+
+  if (!json_is_real(pValue)
+      || json_real_value(pValue) != CCommunicate::TotalProcesses())
+    {
+      CLogger::error("CCheckpoint: The number of parts of checkpoint '{}' does not match the current number of processes ({}).", Checkpoint.output, CCommunicate::TotalProcesses());
+      success = false;
+    }
+
+  pValue = json_object_get(pRoot, "numberOfRanks");
+
+  if (!json_is_real(pValue)
+      || json_real_value(pValue) != CCommunicate::MPIProcesses)
+    {
+      CLogger::error("CCheckpoint: The number of ranks of checkpoint '{}' does not match the current number of ranks ({}).", Checkpoint.output, CCommunicate::MPIProcesses);
+      success = false;
+    }
+
+  pValue = json_object_get(pRoot, "output");
+
+  if (json_is_real(pValue))
+    OutputSize = json_real_value(pValue);
+  else
+    success = false;
+
+  pValue = json_object_get(pRoot, "summaryOutput");
+
+  if (json_is_real(pValue))
+    SummaryOutputSize = json_real_value(pValue);
+  else
+    success = false;
+
+  json_decref(pRoot);
+
+  if (!success)
+    {
+      CLogger::error("CCheckpoint: Invalid checkpoint '{}'.", Checkpoint.output);
+      return false;
+    }
+
+  if (Tick < CSimConfig::getStartTick()
+      || Tick > CSimConfig::getEndTick())
+    {
+      CLogger::error("CCheckpoint: Checkpoint tick '{}' is outside of the simulation interval [{}, {}].", Tick, CSimConfig::getStartTick(), CSimConfig::getEndTick());
+      return false;
+    }
+
+  PreviousTick = Tick;
+  Restart = true;
+
+  return true;
+}
+
+// static
+bool CCheckpoint::isRestart()
+{
+  return Restart;
+}
+
+// static
+const int & CCheckpoint::getTick()
+{
+  return Tick;
+}
+
+// static
+std::string CCheckpoint::getNetwork()
+{
+  return prefix(Tick) + ".network";
+}
+
+// static
+std::string CCheckpoint::prefix(const int & tick)
+{
+  std::ostringstream Prefix;
+  Prefix << CSimConfig::getCheckpoint().output << "[" << tick << "]";
+
+  return Prefix.str();
+}
+
+// static
+bool CCheckpoint::write()
+{
+  const CSimConfig::checkpoint & Checkpoint = CSimConfig::getCheckpoint();
+
+  // Is a checkpoint required?
+  if (Checkpoint.tickIncrement <= 0)
+    return true;
+
+  int CurrentTick = CActionQueue::getCurrentTick();
+
+  if ((CurrentTick - CSimConfig::getStartTick()) % Checkpoint.tickIncrement != 0
+      || CurrentTick == PreviousTick)
+    return true;
+
+  std::chrono::time_point<std::chrono::steady_clock> Start = std::chrono::steady_clock::now();
+  std::string Prefix = prefix(CurrentTick);
+
+  // The recorded sizes of the output require that all pending output is written.
+  bool success = CAsyncWriter::flush();
+
+  success &= CNetwork::writeCheckpoint(Prefix + ".network");
+
+#pragma omp parallel reduction(&: success)
+  {
+    CNetwork & Active = CNetwork::Context.Active();
+
+    std::ostringstream File;
+    File << Prefix << "." << CNetwork::Context.globalIndex(&Active);
+
+    std::ofstream os(File.str().c_str(), std::ios_base::binary);
+
+    if (os.fail())
+      {
+        CLogger::error("CCheckpoint: Failed to open file '{}'.", File.str());
+        success = false;
+      }
+    else
+      {
+        size_t Size = Active.getLocalNodeCount();
+        os.write(reinterpret_cast< const char * >(&Size), sizeof(size_t));
+
+        CNode * pNode = Active.beginNode();
+        CNode * pNodeEnd = Active.endNode();
+
+        for (; pNode != pNodeEnd; ++pNode)
+          pNode->toBinary(os);
+
+        CActionQueue::toBinary(os);
+
+        if (os.fail())
+          {
+            CLogger::error("CCheckpoint: Failed to write file '{}'.", File.str());
+            success = false;
+          }
+
+        os.close();
+      }
+  }
+
+  {
+    std::ostringstream File;
+    File << Prefix << ".rank." << CCommunicate::MPIRank;
+
+    std::ofstream os(File.str().c_str(), std::ios_base::binary);
+
+    success &= writeRank(os);
+
+    if (!success || os.fail())
+      {
+        CLogger::error("CCheckpoint: Failed to write file '{}'.", File.str());
+        success = false;
+      }
+
+    os.close();
+  }
+
+  // The checkpoint is only complete if no rank failed.
+  bool Failed = !success;
+  CCommunicate::allreduceOr(&Failed, 1);
+
+  if (Failed)
+    {
+      CLogger::error("CCheckpoint: Failed to write checkpoint for tick '{}'.", CurrentTick);
+      return false;
+    }
+
+  // The manifest is written last and replaced atomically.
+  if (CCommunicate::MPIRank == 0)
+    {
+      json_t * pRoot = json_object();
+      json_object_set_new(pRoot, "tick", json_integer(CurrentTick));
+      json_object_set_new(pRoot, "numberOfParts", json_integer(CCommunicate::TotalProcesses()));
+      json_object_set_new(pRoot, "numberOfRanks", json_integer(CCommunicate::MPIProcesses));
+      json_object_set_new(pRoot, "output", json_integer(fileSize(CSimConfig::getOutput())));
+      json_object_set_new(pRoot, "summaryOutput", json_integer(fileSize(CSimConfig::getSummaryOutput())));
+
+      std::string Temporary = Checkpoint.output + ".tmp";
+      std::ofstream os(Temporary.c_str());
+
+      os << CSimConfig::jsonToString(pRoot) << std::endl;
+      success &= !os.fail();
+      os.close();
+
+      json_decref(pRoot);
+
+      success &= (std::rename(Temporary.c_str(), Checkpoint.output.c_str()) == 0);
+    }
+
+  // All ranks wait for the manifest before the previous checkpoint is removed.
+  CCommunicate::broadcast(&success, sizeof(bool), 0);
+
+  if (!success)
+    {
+      CLogger::error("CCheckpoint: Failed to write checkpoint manifest '{}'.", Checkpoint.output);
+      return false;
+    }
+
+  if (PreviousTick != std::numeric_limits< int >::min())
+    removeFiles(PreviousTick);
+
+  PreviousTick = CurrentTick;
+
+  CLogger::info("CCheckpoint::write: duration = '{}' \xc2\xb5s.", std::chrono::nanoseconds(std::chrono::steady_clock::now() - Start).count()/1000);
+
+  return true;
+}
+
+// static
+void CCheckpoint::removeFiles(const int & tick)
+{
+  std::string Prefix = prefix(tick);
+  CNetwork * pIt = CNetwork::Context.beginThread();
+  CNetwork * pEnd = CNetwork::Context.endThread();
+
+  for (; pIt != pEnd; ++pIt)
+    {
+      std::ostringstream File;
+      File << Prefix << "." << CNetwork::Context.globalIndex(pIt);
+      CDirEntry::remove(File.str());
+
+      File.str("");
+      File << Prefix << ".network." << CNetwork::Context.globalIndex(pIt);
+      CDirEntry::remove(File.str());
+    }
+
+  std::ostringstream File;
+  File << Prefix << ".rank." << CCommunicate::MPIRank;
+  CDirEntry::remove(File.str());
+
+  if (CCommunicate::MPIRank == 0)
+    CDirEntry::remove(Prefix + ".network");
+}
+
+// static
+bool CCheckpoint::restore()
+{
+  bool success = true;
+  std::string Prefix = prefix(Tick);
+
+  {
+    std::ostringstream File;
+    File << Prefix << ".rank." << CCommunicate::MPIRank;
+
+    std::ifstream is(File.str().c_str(), std::ios_base::binary);
+
+    if (is.fail()
+        || !readRank(is))
+      {
+        CLogger::error("CCheckpoint: Failed to restore '{}'.", File.str());
+        return false;
+      }
+  }
+
+#pragma omp parallel reduction(&: success)
+  {
+    CNetwork & Active = CNetwork::Context.Active();
+
+    std::ostringstream File;
+    File << Prefix << "." << CNetwork::Context.globalIndex(&Active);
+
+    std::ifstream is(File.str().c_str(), std::ios_base::binary);
+    size_t Size = std::numeric_limits< size_t >::max();
+
+    is.read(reinterpret_cast< char * >(&Size), sizeof(size_t));
+
+    if (is.fail()
+        || Size != Active.getLocalNodeCount())
+      {
+        CLogger::error("CCheckpoint: Invalid node count in '{}'.", File.str());
+        success = false;
+      }
+    else
+      {
+        CNode * pNode = Active.beginNode();
+        CNode * pNodeEnd = Active.endNode();
+
+        for (; pNode != pNodeEnd && success; ++pNode)
+          {
+            size_t Id = pNode->id;
+
+            pNode->fromBinary(is);
+            // Assure that the restored state is propagated to remote copies.
+            pNode->changedFields = CNode::AllFields;
+            CChanges::markChanged(pNode);
+
+            if (is.fail()
+                || pNode->id != Id)
+              {
+                CLogger::error("CCheckpoint: Invalid node '{}' in '{}'.", Id, File.str());
+                success = false;
+              }
+          }
+
+        if (success
+            && !CActionQueue::fromBinary(is))
+          {
+            CLogger::error("CCheckpoint: Failed to restore actions from '{}'.", File.str());
+            success = false;
+          }
+      }
+  }
+
+  // Discard any output written after the checkpoint
+  if (success)
+    {
+      if (CSimConfig::getOutputWriter().mode == "perRank")
+        success &= (truncate(CChanges::getDefaultOutput().c_str(), RankOutputSize) == 0);
+      else if (CCommunicate::MPIRank == 0)
+        success &= (truncate(CSimConfig::getOutput().c_str(), OutputSize) == 0);
+
+      if (CCommunicate::MPIRank == 0)
+        success &= (truncate(CSimConfig::getSummaryOutput().c_str(), SummaryOutputSize) == 0);
+
+      if (!success)
+        CLogger::error("CCheckpoint: Failed to truncate output files.");
+    }
+
+  return success;
+}
+
+// static
+bool CCheckpoint::writeRank(std::ostream & os)
+{
+  // Disease model parameters may have been modified by interventions.
+  const std::vector< CHealthState > & States = CModel::GetStates();
+  std::vector< CHealthState >::const_iterator itState = States.begin();
+  std::vector< CHealthState >::const_iterator endState = States.end();
+
+  for (; itState != endState; ++itState)
+    {
+      os.write(reinterpret_cast< const char * >(&itState->getSusceptibility()), sizeof(double));
+      os.write(reinterpret_cast< const char * >(&itState->getInfectivity()), sizeof(double));
+      os.write(reinterpret_cast< const char * >(&itState->getGlobalCounts()), sizeof(CHealthState::Counts));
+
+      const CContext< CHealthState::Counts > & LocalCounts = itState->getLocalCounts();
+      os.write(reinterpret_cast< const char * >(&LocalCounts.Master()), sizeof(CHealthState::Counts));
+
+      const CHealthState::Counts * pIt = LocalCounts.beginThread();
+      const CHealthState::Counts * pEnd = LocalCounts.endThread();
+
+      if (LocalCounts.isThread(pIt))
+        for (; pIt != pEnd; ++pIt)
+          os.write(reinterpret_cast< const char * >(pIt), sizeof(CHealthState::Counts));
+    }
+
+  std::vector< CTransmission >::const_iterator itTransmission = CModel::GetTransmissions().begin();
+  std::vector< CTransmission >::const_iterator endTransmission = CModel::GetTransmissions().end();
+
+  for (; itTransmission != endTransmission; ++itTransmission)
+    {
+      CTransmission & Transmission = const_cast< CTransmission & >(*itTransmission);
+
+      os.write(reinterpret_cast< const char * >(&Transmission.getTransmissibility()), sizeof(double));
+      writeString(os, Transmission.getSusceptibilityFactorOperation());
+      writeString(os, Transmission.getInfectivityFactorOperation());
+    }
+
+  std::vector< CProgression >::const_iterator itProgression = CModel::GetProgressions().begin();
+  std::vector< CProgression >::const_iterator endProgression = CModel::GetProgressions().end();
+
+  for (; itProgression != endProgression; ++itProgression)
+    {
+      CProgression & Progression = const_cast< CProgression & >(*itProgression);
+
+      os.write(reinterpret_cast< const char * >(&Progression.getPropensity()), sizeof(double));
+      writeString(os, Progression.getDwellTime());
+      writeString(os, Progression.getSusceptibilityFactorOperation());
+      writeString(os, Progression.getInfectivityFactorOperation());
+
+      std::ostringstream Distribution;
+      Progression.getDwellTimeDistribution().toCheckpoint(Distribution);
+      writeString(os, Distribution.str());
+    }
+
+  CVariableList::INSTANCE.toCheckpoint(os);
+
+  CRandom::result_t Seed = CRandom::getSeed();
+  os.write(reinterpret_cast< const char * >(&Seed), sizeof(CRandom::result_t));
+
+  // The master generator is written first followed by the thread generators if they are distinct.
+  std::ostringstream MasterState;
+  MasterState << CRandom::G.Master();
+  writeString(os, MasterState.str());
+
+  CRandom::generator_t * pGenerator = CRandom::G.beginThread();
+  CRandom::generator_t * pGeneratorEnd = CRandom::G.endThread();
+
+  if (CRandom::G.isThread(pGenerator))
+    for (; pGenerator != pGeneratorEnd; ++pGenerator)
+      {
+        std::ostringstream State;
+        State << *pGenerator;
+        writeString(os, State.str());
+      }
+
+  // Each rank writes its own default output in the perRank output writer mode.
+  size_t Size = fileSize(CChanges::getDefaultOutput());
+  os.write(reinterpret_cast< const char * >(&Size), sizeof(size_t));
+
+  return !os.fail();
+}
+
+// static
+bool CCheckpoint::readRank(std::istream & is)
+{
+  static CMetadata Info("Checkpoint", true);
+
+  bool success = true;
+
+  std::vector< CHealthState >::const_iterator itState = CModel::GetStates().begin();
+  std::vector< CHealthState >::const_iterator endState = CModel::GetStates().end();
+
+  for (; itState != endState; ++itState)
+    {
+      CHealthState & State = const_cast< CHealthState & >(*itState);
+      double Value;
+      CHealthState::Counts Counts;
+
+      is.read(reinterpret_cast< char * >(&Value), sizeof(double));
+      success &= State.setSusceptibility(Value, &CValueInterface::equal, Info);
+      is.read(reinterpret_cast< char * >(&Value), sizeof(double));
+      success &= State.setInfectivity(Value, &CValueInterface::equal, Info);
+
+      is.read(reinterpret_cast< char * >(&Counts), sizeof(CHealthState::Counts));
+      State.setGlobalCounts(Counts);
+
+      CContext< CHealthState::Counts > & LocalCounts = State.getLocalCounts();
+      is.read(reinterpret_cast< char * >(&LocalCounts.Master()), sizeof(CHealthState::Counts));
+
+      CHealthState::Counts * pIt = LocalCounts.beginThread();
+      CHealthState::Counts * pEnd = LocalCounts.endThread();
+
+      if (LocalCounts.isThread(pIt))
+        for (; pIt != pEnd; ++pIt)
+          is.read(reinterpret_cast< char * >(pIt), sizeof(CHealthState::Counts));
+    }
+
+  std::vector< CTransmission >::const_iterator itTransmission = CModel::GetTransmissions().begin();
+  std::vector< CTransmission >::const_iterator endTransmission = CModel::GetTransmissions().end();
+
+  for (; itTransmission != endTransmission; ++itTransmission)
+    {
+      CTransmission & Transmission = const_cast< CTransmission & >(*itTransmission);
+      double Value;
+      std::string Operation;
+
+      is.read(reinterpret_cast< char * >(&Value), sizeof(double));
+      success &= Transmission.setTransmissibility(Value, &CValueInterface::equal, Info);
+      // Note: setting an unchanged operation returns false.
+      readString(is, Operation);
+      Transmission.setSusceptibilityFactorOperation(Operation, &CValueInterface::equal, Info);
+      readString(is, Operation);
+      Transmission.setInfectivityFactorOperation(Operation, &CValueInterface::equal, Info);
+    }
+
+  std::vector< CProgression >::const_iterator itProgression = CModel::GetProgressions().begin();
+  std::vector< CProgression >::const_iterator endProgression = CModel::GetProgressions().end();
+
+  for (; itProgression != endProgression; ++itProgression)
+    {
+      CProgression & Progression = const_cast< CProgression & >(*itProgression);
+      double Value;
+      std::string Json;
+
+      is.read(reinterpret_cast< char * >(&Value), sizeof(double));
+      success &= Progression.setPropensity(Value, &CValueInterface::equal, Info);
+      // Note: setting an unchanged distribution or operation returns false.
+      readString(is, Json);
+      Progression.setDwellTime(Json, &CValueInterface::equal, Info);
+      readString(is, Json);
+      Progression.setSusceptibilityFactorOperation(Json, &CValueInterface::equal, Info);
+      readString(is, Json);
+      Progression.setInfectivityFactorOperation(Json, &CValueInterface::equal, Info);
+
+      // The distribution state must be restored after the dwell time is set.
+      readString(is, Json);
+      std::istringstream Distribution(Json);
+      success &= Progression.getDwellTimeDistribution().fromCheckpoint(Distribution);
+    }
+
+  success &= CVariableList::INSTANCE.fromCheckpoint(is);
+
+  // Restore the reported seed; the generator states are overwritten below.
+  CRandom::result_t Seed;
+  is.read(reinterpret_cast< char * >(&Seed), sizeof(CRandom::result_t));
+  CRandom::seed(Seed);
+
+  std::string State;
+  readString(is, State);
+
+  std::istringstream MasterState(State);
+  MasterState >> CRandom::G.Master();
+  success &= !MasterState.fail();
+
+  CRandom::generator_t * pGenerator = CRandom::G.beginThread();
+  CRandom::generator_t * pGeneratorEnd = CRandom::G.endThread();
+
+  if (CRandom::G.isThread(pGenerator))
+    for (; pGenerator != pGeneratorEnd; ++pGenerator)
+      {
+        readString(is, State);
+
+        std::istringstream StateStream(State);
+        StateStream >> *pGenerator;
+        success &= !StateStream.fail();
+      }
+
+  is.read(reinterpret_cast< char * >(&RankOutputSize), sizeof(size_t));
+
+  return success && !is.fail();
+}
+
+// static
+void CCheckpoint::writeString(std::ostream & os, const std::string & str)
+{
+  size_t Length = str.length();
+  os.write(reinterpret_cast< const char * >(&Length), sizeof(size_t));
+  os.write(str.c_str(), Length);
+}
+
+// static
+void CCheckpoint::readString(std::istream & is, std::string & str)
+{
+  size_t Length = 0;
+  is.read(reinterpret_cast< char * >(&Length), sizeof(size_t));
+
+  if (is.fail())
+    {
+      str.clear();
+      return;
+    }
+
+  str.resize(Length);
+  is.read(&str[0], Length);
+}
+
+// static
+size_t CCheckpoint::fileSize(const std::string & file)
+{
+  std::ifstream is(file.c_str(), std::ios_base::binary | std::ios_base::ate);
+
+  if (is.fail())
+    return 0;
+
+  return is.tellg();
+}
@@ -0,0 +1,112 @@
+// BEGIN: Copyright 
+// MIT License 
+//  
+// Copyright (C) 2019 - 2023 Rector and Visitors of the University of Virginia 
+//  
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell 
+// copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions: 
+//  
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software. 
+//  
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, 
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE 
+// END: Copyright 
+
+#ifndef SRC_UTILITIES_CCHECKPOINT_H_
+#define SRC_UTILITIES_CCHECKPOINT_H_
+
+#include <string>
+#include <iostream>
+
+/**
+ * Checkpoint and restart of a simulation at tick boundaries.
+ *
+ * A checkpoint for tick T with the configured output prefix P consists of:
+ *   P[T].network and P[T].network.<part>  the partitioned binary contact network (including edge state),
+ *   P[T].<part>                           the nodes and the pending actions of each thread,
+ *   P[T].rank.<rank>                      the model parameters, state counts, variables, and random generators,
+ *   P                                     the JSON manifest, which is written last and thus marks the checkpoint as complete.
+ */
+class CCheckpoint
+{
+public:
+  /**
+   * Load the manifest of the checkpoint from which the simulation is restarted.
+   * @return bool success
+   */
+  static bool load();
+
+  static bool isRestart();
+
+  /**
+   * The tick at which the checkpoint was written
+   * @return const int & tick
+   */
+  static const int & getTick();
+
+  /**
+   * The contact network stored with the checkpoint
+   * @return std::string network
+   */
+  static std::string getNetwork();
+
+  /**
+   * Write a checkpoint if one is due for the current tick.
+   * This must be called outside of a parallel region.
+   * @return bool success
+   */
+  static bool write();
+
+  /**
+   * Restore the simulation state from the checkpoint. The network must be loaded
+   * and the current tick must be set to the checkpoint tick.
+   * This must be called outside of a parallel region.
+   * @return bool success
+   */
+  static bool restore();
+
+  /**
+   * Write the state of this rank which is not stored with the nodes, i.e., the model parameters,
+   * state counts, variables, and the master and thread random generators.
+   * @param std::ostream & os
+   * @return bool success
+   */
+  static bool writeRank(std::ostream & os);
+
+  /**
+   * Restore the state written by writeRank
+   * @param std::istream & is
+   * @return bool success
+   */
+  static bool readRank(std::istream & is);
+
+private:
+  static std::string prefix(const int & tick);
+
+  static void removeFiles(const int & tick);
+
+  static void writeString(std::ostream & os, const std::string & str);
+
+  static void readString(std::istream & is, std::string & str);
+
+  static size_t fileSize(const std::string & file);
+
+  static bool Restart;
+  static int Tick;
+  static int PreviousTick;
+  static size_t OutputSize;
+  static size_t SummaryOutputSize;
+  static size_t RankOutputSize;
+};
+
+#endif /* SRC_UTILITIES_CCHECKPOINT_H_ */
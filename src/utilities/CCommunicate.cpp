@@ -28,10 +28,13 @@
 #include <cassert>
 #include <sstream>
 #include <chrono>
+#include <limits>
+#include <cstdint>
 
 #include "utilities/CLogger.h"
 #include "utilities/CCommunicate.h"
 #include "utilities/CStreamBuffer.h"
+#include "actions/CAction.h"
 
 // static
 void CCommunicate::resizeReceiveBuffer(int size)
@@ -712,6 +715,209 @@ int CCommunicate::roundRobin(SendInterface * pSend,
   return (int) Result;
 }
 
+// static
+#ifdef USE_MPI
+int CCommunicate::allreduceSum(size_t * values, int count)
+{
+  static_assert(sizeof(size_t) == sizeof(uint64_t), "size_t must be a 64 bit unsigned integer");
+
+  std::chrono::time_point<std::chrono::steady_clock> Start = std::chrono::steady_clock::now();
+
+  int Result = MPI_Allreduce(MPI_IN_PLACE, values, count, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+
+  CLogger::info("CCommunicate::allreduceSum: duration = '{}' \xc2\xb5s.", std::chrono::nanoseconds(std::chrono::steady_clock::now() - Start).count()/1000);
+
+  return Result;
+}
+#else
+int CCommunicate::allreduceSum(size_t * /* values */, int /* count */)
+{
+  return MPI_SUCCESS;
+}
+#endif // USE_MPI
+
+// static
+#ifdef USE_MPI
+int CCommunicate::allreduceOr(bool * values, int count)
+{
+  std::chrono::time_point<std::chrono::steady_clock> Start = std::chrono::steady_clock::now();
+
+  int Result = MPI_Allreduce(MPI_IN_PLACE, values, count, MPI_CXX_BOOL, MPI_LOR, MPI_COMM_WORLD);
+
+  CLogger::info("CCommunicate::allreduceOr: duration = '{}' \xc2\xb5s.", std::chrono::nanoseconds(std::chrono::steady_clock::now() - Start).count()/1000);
+
+  return Result;
+}
+#else
+int CCommunicate::allreduceOr(bool * /* values */, int /* count */)
+{
+  return MPI_SUCCESS;
+}
+#endif // USE_MPI
+
+// static
+#ifdef USE_MPI
+int CCommunicate::startExchange(SendInterface * pSend,
+                                const std::vector< int > & sendTo)
+{
+  ErrorCode Result = ErrorCode::Success;
+
+  ExchangeBuffers.resize(sendTo.size());
+  ExchangeRequests.resize(sendTo.size());
+
+  std::vector< int >::const_iterator itRank = sendTo.begin();
+  std::vector< int >::const_iterator endRank = sendTo.end();
+  std::vector< std::string >::iterator itBuffer = ExchangeBuffers.begin();
+  std::vector< MPI_Request >::iterator itRequest = ExchangeRequests.begin();
+
+  for (; itRank != endRank; ++itRank, ++itBuffer, ++itRequest)
+    {
+      std::ostringstream os;
+      Result = (*pSend)(os, *itRank);
+      *itBuffer = os.str();
+
+      CLogger::debug("CCommunicate::startExchange: '{}' bytes to '{}'.", itBuffer->size(), *itRank);
+      MPI_Isend(itBuffer->c_str(), itBuffer->size(), MPI_CHAR, *itRank, ExchangeTag, MPI_COMM_WORLD, &*itRequest);
+    }
+
+  return (int) Result;
+}
+#else
+int CCommunicate::startExchange(SendInterface * /* pSend */,
+                                const std::vector< int > & /* sendTo */)
+{
+  return MPI_SUCCESS;
+}
+#endif // USE_MPI
+
+// static
+#ifdef USE_MPI
+int CCommunicate::finishExchange(const std::vector< int > & receiveFrom,
+                                 ReceiveInterface * pReceive)
+{
+  std::chrono::time_point<std::chrono::steady_clock> Start = std::chrono::steady_clock::now();
+
+  ErrorCode Result = ErrorCode::Success;
+  Status status;
+  int Count;
+
+  // Each rank sends exactly one message per exchange, i.e., we can process them as they arrive.
+  for (size_t i = 0; i < receiveFrom.size(); ++i)
+    {
+      MPI_Probe(MPI_ANY_SOURCE, ExchangeTag, MPI_COMM_WORLD, &status);
+      MPI_Get_count(&status, MPI_CHAR, &Count);
+
+      resizeReceiveBuffer(Count);
+      MPI_Recv(ReceiveBuffer, Count, MPI_CHAR, status.MPI_SOURCE, ExchangeTag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+      if (Count > 0)
+        {
+          CStreamBuffer Buffer(ReceiveBuffer, Count);
+          std::istream is(&Buffer);
+
+          Result = (*pReceive)(is, status.MPI_SOURCE);
+        }
+    }
+
+  if (!ExchangeRequests.empty())
+    MPI_Waitall(ExchangeRequests.size(), ExchangeRequests.data(), MPI_STATUSES_IGNORE);
+
+  ExchangeRequests.clear();
+  ExchangeBuffers.clear();
+
+  CLogger::info("CCommunicate::finishExchange: duration = '{}' \xc2\xb5s.", std::chrono::nanoseconds(std::chrono::steady_clock::now() - Start).count()/1000);
+
+  return (int) Result;
+}
+#else
+int CCommunicate::finishExchange(const std::vector< int > & /* receiveFrom */,
+                                 ReceiveInterface * /* pReceive */)
+{
+  return MPI_SUCCESS;
+}
+#endif // USE_MPI
+
+// static
+#ifdef USE_MPI
+int CCommunicate::appendAll(const std::string & file,
+                            const std::string & data)
+{
+  std::chrono::time_point<std::chrono::steady_clock> Start = std::chrono::steady_clock::now();
+
+  MPI_File File;
+
+  if (MPI_File_open(MPI_COMM_WORLD, file.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &File) != MPI_SUCCESS)
+    return (int) ErrorCode::FileOpenError;
+
+  // Rank 0 contributes the current file size so that the prefix sum yields absolute offsets.
+  unsigned long long Size = data.size();
+
+  if (MPIRank == 0)
+    {
+      MPI_Offset FileSize;
+      MPI_File_get_size(File, &FileSize);
+      Size += FileSize;
+    }
+
+  unsigned long long Offset = 0;
+  MPI_Exscan(&Size, &Offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+  if (MPIRank == 0)
+    Offset = Size - data.size();
+
+  // The count of a single write is limited to int. All ranks must participate in each collective write.
+  static const size_t MaxChunk = std::numeric_limits< int >::max();
+  unsigned long long Chunks = (data.size() + MaxChunk - 1) / MaxChunk;
+  unsigned long long TotalChunks = 0;
+  MPI_Allreduce(&Chunks, &TotalChunks, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+
+  ErrorCode Result = ErrorCode::Success;
+  const char * pData = data.c_str();
+  size_t Remaining = data.size();
+
+  for (unsigned long long i = 0; i < TotalChunks; ++i)
+    {
+      int Count = std::min(Remaining, MaxChunk);
+
+      if (MPI_File_write_at_all(File, Offset, pData, Count, MPI_CHAR, MPI_STATUS_IGNORE) != MPI_SUCCESS)
+        Result = ErrorCode::FileWriteError;
+
+      Offset += Count;
+      pData += Count;
+      Remaining -= Count;
+    }
+
+  if (MPI_File_close(&File) != MPI_SUCCESS
+      && Result == ErrorCode::Success)
+    Result = ErrorCode::FileCloseError;
+
+  CLogger::info("CCommunicate::appendAll: duration = '{}' \xc2\xb5s.", std::chrono::nanoseconds(std::chrono::steady_clock::now() - Start).count()/1000);
+
+  return (int) Result;
+}
+#else
+int CCommunicate::appendAll(const std::string & file,
+                            const std::string & data)
+{
+  std::ofstream out(file.c_str(), std::ios_base::app);
+
+  if (out.fail())
+    return (int) ErrorCode::FileOpenError;
+
+  out << data;
+
+  if (out.fail())
+    return (int) ErrorCode::FileWriteError;
+
+  out.close();
+
+  if (out.fail())
+    return (int) ErrorCode::FileCloseError;
+
+  return (int) ErrorCode::Success;
+}
+#endif // USE_MPI
+
 // static
 int CCommunicate::allocateRMA()
 {
@@ -725,7 +931,7 @@ int CCommunicate::allocateRMA()
           /* Everyone will retrieve from a buffer on root */
           RMABuffer = new double[MPIWinSize];
 #ifdef USE_MPI
-          result = MPI_Win_create(RMABuffer, MPIWinSize, sizeof(double), MPI_INFO_NULL, MPI_COMM_WORLD, &MPIWin);
+          result = MPI_Win_create(RMABuffer, MPIWinSize * sizeof(double), sizeof(double), MPI_INFO_NULL, MPI_COMM_WORLD, &MPIWin);
 #endif // USE_MPI
         }
       else
@@ -809,6 +1015,27 @@ double CCommunicate::updateRMA(const int & index, CCommunicate::Operator pOperat
   return Value;
 }
 
+// static
+int CCommunicate::accumulateRMA(const int & index, const CCommunicate::Accumulation & accumulation, const double & value)
+{
+  int result = (int) ErrorCode::Success;
+
+  if (index < (int) MPIWinSize)
+#pragma omp critical (access_rma)
+    {
+#ifdef USE_MPI
+      MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, MPIWin);
+      result = MPI_Accumulate(&value, 1, MPI_DOUBLE, 0, (int) index, 1, MPI_DOUBLE, accumulation == Accumulation::Sum ? MPI_SUM : MPI_PROD, MPIWin);
+      MPI_Win_unlock(0, MPIWin);
+#else
+      (void) accumulation;
+      (void) value;
+#endif // USE_MPI
+    }
+
+  return result;
+}
+
 // static
 size_t CCommunicate::getRMAIndex()
 {
@@ -840,6 +1067,13 @@ void CCommunicate::memUsage()
   resident_set = rss * page_size_kb;
 
   CLogger::info("Memory VM: {}; RSS: {}", (size_t) vm_usage, (size_t) resident_set);
+
+  size_t Live;
+  size_t Allocations;
+  size_t Reserved;
+
+  CAction::poolUsage(Live, Allocations, Reserved);
+  CLogger::info("Memory actions: {}; allocated: {}; pooled: {}", Live, Allocations, Reserved / 1024);
 }
 
 CCommunicate::~CCommunicate()
@@ -26,6 +26,8 @@
 #define SRC_COMMUNICATE_H_
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "utilities/CContext.h"
 
@@ -41,6 +43,12 @@ class CCommunicate
 public:
   typedef void (*Operator)(double &, const double &);
 
+  enum struct Accumulation
+  {
+    Sum,
+    Product
+  };
+
   enum struct ErrorCode
   {
     Success = MPI_SUCCESS,
@@ -255,6 +263,52 @@ public:
   static int roundRobin(SendInterface * pSend,
                         ReceiveInterface * pReceive);
 
+  /**
+   * Replace the values with their element wise sums over all ranks
+   * @param size_t * values
+   * @param int count
+   * @return int result
+   */
+  static int allreduceSum(size_t * values, int count);
+
+  /**
+   * Replace the values with their element wise logical or over all ranks
+   * @param bool * values
+   * @param int count
+   * @return int result
+   */
+  static int allreduceOr(bool * values, int count);
+
+  /**
+   * Start a non blocking exchange. The data created by pSend for each of the ranks in sendTo
+   * are sent immediately and the exchange must be completed by calling finishExchange.
+   * @param SendInterface * pSend
+   * @param const std::vector< int > & sendTo
+   * @return int result
+   */
+  static int startExchange(SendInterface * pSend,
+                           const std::vector< int > & sendTo);
+
+  /**
+   * Complete a non blocking exchange by receiving one message from each of the ranks in
+   * receiveFrom in the order of arrival.
+   * @param const std::vector< int > & receiveFrom
+   * @param ReceiveInterface * pReceive
+   * @return int result
+   */
+  static int finishExchange(const std::vector< int > & receiveFrom,
+                            ReceiveInterface * pReceive);
+
+  /**
+   * Collectively append the data of all ranks to the file. The data are written concurrently in
+   * the order of the ranks at offsets determined by an exclusive prefix sum of their sizes.
+   * @param const std::string & file
+   * @param const std::string & data
+   * @return int result
+   */
+  static int appendAll(const std::string & file,
+                       const std::string & data);
+
   static int abortMessage(ErrorCode err, const std::string & msg, const char * file, int line);
 
   static int abort(ErrorCode errorcode);
@@ -269,6 +323,16 @@ public:
 
   static double updateRMA(const int & index, Operator pOperator, const double & value);
 
+  /**
+   * Combine the value with the global value at index using a commutative operation. Unlike
+   * updateRMA this does not require exclusive access to the global value.
+   * @param const int & index
+   * @param const Accumulation & accumulation
+   * @param const double & value
+   * @return int result
+   */
+  static int accumulateRMA(const int & index, const Accumulation & accumulation, const double & value);
+
   static size_t getRMAIndex();
 
   static void memUsage();
@@ -285,6 +349,9 @@ private:
   static size_t MPIWinSize;
   static double * RMABuffer;
   static size_t RMAIndex;
+  static std::vector< std::string > ExchangeBuffers;
+  static std::vector< MPI_Request > ExchangeRequests;
+  static const int ExchangeTag;
 
   static void resizeReceiveBuffer(int size);
 
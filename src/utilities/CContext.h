@@ -34,6 +34,7 @@
   typedef int MPI_Status;
   typedef int MPI_Comm;
   typedef int MPI_Win;
+  typedef int MPI_Request;
 # define MPI_COMM_WORLD 1
 # define MPI_SUCCESS 0
 # define MPI_ERR_UNKNOWN 2
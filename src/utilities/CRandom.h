@@ -26,6 +26,7 @@
 #define SRC_UTILITIES_CRANDOM_H_
 
 #include <random>
+#include <iostream>
 
 #include "utilities/CContext.h"
 
@@ -87,6 +88,38 @@ public:
       
       return Active.distribution.operator()(*Active.pGenerator);
     }
+
+    /**
+     * Write the internal state of the master and thread distributions
+     * @param std::ostream & os
+     */
+    void toStream(std::ostream & os) const
+    {
+      os << base::Master().distribution << ' ';
+
+      const context_type * pIt = base::beginThread();
+      const context_type * pEnd = base::endThread();
+
+      if (base::isThread(pIt))
+        for (; pIt != pEnd; ++pIt)
+          os << pIt->distribution << ' ';
+    }
+
+    /**
+     * Restore the internal state of the master and thread distributions
+     * @param std::istream & is
+     */
+    void fromStream(std::istream & is)
+    {
+      is >> base::Master().distribution;
+
+      context_type * pIt = base::beginThread();
+      context_type * pEnd = base::endThread();
+
+      if (base::isThread(pIt))
+        for (; pIt != pEnd; ++pIt)
+          is >> pIt->distribution;
+    }
   };
 
   typedef std::uniform_int_distribution< result_t > uniform_int;
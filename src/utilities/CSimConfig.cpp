@@ -104,7 +104,12 @@ const std::vector< std::string > & CSimConfig::getPersonTraitDB()
 // static
 const std::string & CSimConfig::getOutput()
 {
-  return CSimConfig::INSTANCE->mOutput;
+  static const std::string Default;
+
+  if (CSimConfig::INSTANCE != NULL)
+    return CSimConfig::INSTANCE->mOutput;
+
+  return Default;
 }
 
 // static
@@ -155,6 +160,15 @@ const size_t & CSimConfig::getPartitionEdgeLimit()
   return CSimConfig::INSTANCE->mPartitionEdgeLimit;
 }
 
+// static
+bool CSimConfig::getTransmissionMirror()
+{
+  if (CSimConfig::INSTANCE != NULL)
+    return CSimConfig::INSTANCE->mTransmissionMirror;
+
+  return false;
+}
+
 // static
 CLogger::LogLevel CSimConfig::getLogLevel()
 {
@@ -175,6 +189,34 @@ const CSimConfig::dump_active_network & CSimConfig::getDumpActiveNetwork()
 {
   return CSimConfig::INSTANCE->mDumpActiveNetwork;
 }
+
+// static 
+const CSimConfig::checkpoint & CSimConfig::getCheckpoint()
+{
+  return CSimConfig::INSTANCE->mCheckpoint;
+}
+
+// static 
+const CSimConfig::node_exchange & CSimConfig::getNodeExchange()
+{
+  static const node_exchange Default;
+
+  if (CSimConfig::INSTANCE != NULL)
+    return CSimConfig::INSTANCE->mNodeExchange;
+
+  return Default;
+}
+
+// static 
+const CSimConfig::output_writer & CSimConfig::getOutputWriter()
+{
+  static const output_writer Default;
+
+  if (CSimConfig::INSTANCE != NULL)
+    return CSimConfig::INSTANCE->mOutputWriter;
+
+  return Default;
+}
   
 // constructor: parse JSON
 CSimConfig::CSimConfig(const std::string & configFile)
@@ -197,6 +239,7 @@ CSimConfig::CSimConfig(const std::string & configFile)
   , mReseed()
   , mReplicate(std::numeric_limits< size_t >::max())
   , mPartitionEdgeLimit(100000000)
+  , mTransmissionMirror(false)
   , mDBConnection()
 {
   if (mRunParameters.empty())
@@ -289,6 +332,10 @@ CSimConfig::CSimConfig(const std::string & configFile)
       "description": "The maximum number of network edges which are partitioned on the fly.",
       "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
     },
+    "transmissionMirror": {
+      "description": "Maintain a structure of arrays copy of the node and edge data used when processing transmissions (default: false).",
+      "type": "boolean"
+    },
     "logLevel": {
       "description": "The logging level (default warn)",
       "type": "string",
@@ -336,6 +383,13 @@ CSimConfig::CSimConfig(const std::string & configFile)
       "description": "The maximal delay in milli seconds for attempting a connection (default: 500)",
       "$ref": "./typeRegistry.json#/definitions/nonNegativeInteger"
     },
+    "dbBackend": {
+      "description": "postgres: the person trait DB sets are queried from the database; memory: each rank loads the rows of the person trait DB files for the nodes it knows once and evaluates the queries in memory (default: postgres).",
+      "enum": [
+        "postgres",
+        "memory"
+      ]
+    },
     "dumpActiveNetwork": {
       "type": "object",
       "description": "If present causes regular dumps of the active network",
@@ -377,6 +431,76 @@ CSimConfig::CSimConfig(const std::string & configFile)
             "text",
             "binary"
           ]
+        },
+        "asynchronous": {
+          "description": "If true, a background thread per rank writes the output while the simulation proceeds with the next tick. This does not apply to the sequential and collective modes with more than one rank (default: false).",
+          "type": "boolean"
+        },
+        "queueSize": {
+          "description": "The maximal number of pending writes of the background thread after which the simulation waits (default: 4).",
+          "type": "number",
+          "minimum": 1,
+          "multipleOf": 1.0
+        }
+      }
+    },
+    "checkpoint": {
+      "type": "object",
+      "description": "If present causes regular checkpoints from which the simulation can be restarted (--restart)",
+      "required": [
+        "tickIncrement"
+      ],
+      "properties": {
+        "output": {
+          "description": "Path + name of the checkpoint manifest (default: /output/checkpoint)",
+          "$ref": "./typeRegistry.json#/definitions/localPath"
+        },
+        "tickIncrement": {
+          "description": "The number of ticks between checkpoints.",
+          "type": "number",
+          "minimum": 1,
+          "multipleOf": 1.0
+        }
+      }
+    },
+    "nodeExchange": {
+      "type": "object",
+      "description": "Controls how the changes of nodes are exchanged between ranks after each tick",
+      "properties": {
+        "mode": {
+          "description": "roundRobin: blocking pairwise exchange with all ranks; nonBlocking: non blocking exchange with the ranks sharing nodes, which overlaps with writing the output (default: roundRobin).",
+          "enum": [
+            "roundRobin",
+            "nonBlocking"
+          ]
+        },
+        "encoding": {
+          "description": "compact: delta encoded ids and only the changed fields of each node; full: the complete binary data of each node (default: compact).",
+          "enum": [
+            "compact",
+            "full"
+          ]
+        }
+      }
+    },
+    "outputWriter": {
+      "type": "object",
+      "description": "Controls how the ranks write the per tick output",
+      "properties": {
+        "mode": {
+          "description": "sequential: the ranks append to the output one after another; collective: all ranks write concurrently into the output at offsets determined by a prefix sum; perRank: each rank writes the file <output>.<rank> and rank 0 writes the manifest <output>.manifest listing them (default: sequential).",
+          "enum": [
+            "sequential",
+            "collective",
+            "perRank"
+          ]
+        },
+        "format": {
+          "description": "csv: text output; binary: columnar blocks of transitions with dictionary encoded states, compressed with zlib if available, which EpiHiperOutputConverter converts to csv (default: csv).",
+          "enum": [
+            "csv",
+            "binary"
+          ]
         }
       }
     }
@@ -531,6 +655,13 @@ CSimConfig::CSimConfig(const std::string & configFile)
       mPartitionEdgeLimit = json_real_value(pValue);
     }
 
+  pValue = json_object_get(pRoot, "transmissionMirror");
+
+  if (json_is_boolean(pValue))
+    {
+      mTransmissionMirror = json_is_true(pValue);
+    }
+
   pValue = json_object_get(pRoot, "logLevel");
 
   if (json_is_string(pValue))
@@ -562,6 +693,7 @@ CSimConfig::CSimConfig(const std::string & configFile)
   mDBConnection.connectionTimeout = 2;
   mDBConnection.connectionRetries = 15;
   mDBConnection.connectionMaxDelay = 500;
+  mDBConnection.backend = "postgres";
 
   pValue = json_object_get(pRoot, "dbName");
 
@@ -619,6 +751,15 @@ CSimConfig::CSimConfig(const std::string & configFile)
       mDBConnection.connectionMaxDelay = json_real_value(pValue);
     }
 
+  pValue = json_object_get(pRoot, "dbBackend");
+
+  if (json_is_string(pValue))
+    {
+      mDBConnection.backend = json_string_value(pValue);
+    }
+
+  valid &= mDBConnection.backend == "postgres" || mDBConnection.backend == "memory";
+
   mDumpActiveNetwork.output = "";
   mDumpActiveNetwork.threshold = -1.0;
   mDumpActiveNetwork.startTick = mStartTick;
@@ -687,6 +828,97 @@ CSimConfig::CSimConfig(const std::string & configFile)
       valid &= mDumpActiveNetwork.encoding == "text" || mDumpActiveNetwork.encoding == "binary";
     }
 
+  mCheckpoint.output = "";
+  mCheckpoint.tickIncrement = 0;
+
+  json_t * pCheckpoint = json_object_get(pRoot, "checkpoint");
+
+  if (json_is_object(pCheckpoint))
+    {
+      pValue = json_object_get(pCheckpoint, "output");
+
+      if (json_is_string(pValue))
+        mCheckpoint.output = json_string_value(pValue);
+      else
+        mCheckpoint.output = "checkpoint";
+
+      mCheckpoint.output = CDirEntry::resolve(mCheckpoint.output, mRunParameters, DefaultDir);
+
+      if (!CDirEntry::exist(CDirEntry::dirName(mCheckpoint.output)))
+        CDirEntry::createDir(CDirEntry::dirName(mCheckpoint.output));
+
+      pValue = json_object_get(pCheckpoint, "tickIncrement");
+
+      if (json_is_real(pValue))
+        {
+          mCheckpoint.tickIncrement = json_real_value(pValue);
+        }
+
+      valid &= mCheckpoint.tickIncrement > 0;
+    }
+
+  json_t * pNodeExchange = json_object_get(pRoot, "nodeExchange");
+
+  if (json_is_object(pNodeExchange))
+    {
+      pValue = json_object_get(pNodeExchange, "mode");
+
+      if (json_is_string(pValue))
+        {
+          mNodeExchange.mode = json_string_value(pValue);
+        }
+
+      valid &= mNodeExchange.mode == "roundRobin" || mNodeExchange.mode == "nonBlocking";
+
+      pValue = json_object_get(pNodeExchange, "encoding");
+
+      if (json_is_string(pValue))
+        {
+          mNodeExchange.encoding = json_string_value(pValue);
+        }
+
+      valid &= mNodeExchange.encoding == "compact" || mNodeExchange.encoding == "full";
+    }
+
+  json_t * pOutputWriter = json_object_get(pRoot, "outputWriter");
+
+  if (json_is_object(pOutputWriter))
+    {
+      pValue = json_object_get(pOutputWriter, "mode");
+
+      if (json_is_string(pValue))
+        {
+          mOutputWriter.mode = json_string_value(pValue);
+        }
+
+      valid &= mOutputWriter.mode == "sequential" || mOutputWriter.mode == "collective" || mOutputWriter.mode == "perRank";
+
+      pValue = json_object_get(pOutputWriter, "format");
+
+      if (json_is_string(pValue))
+        {
+          mOutputWriter.format = json_string_value(pValue);
+        }
+
+      valid &= mOutputWriter.format == "csv" || mOutputWriter.format == "binary";
+
+      pValue = json_object_get(pOutputWriter, "asynchronous");
+
+      if (json_is_boolean(pValue))
+        {
+          mOutputWriter.asynchronous = json_is_true(pValue);
+        }
+
+      pValue = json_object_get(pOutputWriter, "queueSize");
+
+      if (json_is_real(pValue))
+        {
+          mOutputWriter.queueSize = json_real_value(pValue);
+        }
+
+      valid &= mOutputWriter.queueSize > 0;
+    }
+
   json_decref(pRoot);
 
   valid &= loadScenario();
@@ -46,6 +46,7 @@ public:
     size_t connectionTimeout;
     size_t connectionRetries;
     size_t connectionMaxDelay;
+    std::string backend;
   };
 
   struct dump_active_network
@@ -58,6 +59,26 @@ public:
     std::string encoding;
   };
 
+  struct checkpoint
+  {
+    std::string output;
+    int tickIncrement = 0;
+  };
+
+  struct node_exchange
+  {
+    std::string mode = "roundRobin";
+    std::string encoding = "compact";
+  };
+
+  struct output_writer
+  {
+    std::string mode = "sequential";
+    std::string format = "csv";
+    bool asynchronous = false;
+    size_t queueSize = 4;
+  };
+
 private:
   bool valid;
 
@@ -83,9 +104,13 @@ private:
   std::map< int, size_t > mReseed;
   size_t mReplicate;
   size_t mPartitionEdgeLimit;
+  bool mTransmissionMirror;
   CLogger::LogLevel mLogLevel;
   db_connection mDBConnection;
   dump_active_network mDumpActiveNetwork;
+  checkpoint mCheckpoint;
+  node_exchange mNodeExchange;
+  output_writer mOutputWriter;
 
 private:
   static CSimConfig * INSTANCE;
@@ -117,9 +142,13 @@ public:
   static const std::map< int, size_t> & getReseed();
   static const size_t & getReplicate();
   static const size_t & getPartitionEdgeLimit();
+  static bool getTransmissionMirror();
   static CLogger::LogLevel getLogLevel();
   static const db_connection & getDBConnection();
   static const dump_active_network & getDumpActiveNetwork();
+  static const checkpoint & getCheckpoint();
+  static const node_exchange & getNodeExchange();
+  static const output_writer & getOutputWriter();
   static json_t * loadJson(const std::string & jsonFile, int flags);
   static json_t * loadJsonPreamble(const std::string & jsonFile, int flags);
   static std::string jsonToString(const json_t * pJson);
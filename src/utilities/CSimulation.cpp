@@ -33,6 +33,7 @@
 #include "utilities/CLogger.h"
 #include "actions/CActionQueue.h"
 #include "actions/CChanges.h"
+#include "db/CQueryCache.h"
 #include "diseaseModel/CModel.h"
 #include "intervention/CInitialization.h"
 #include "intervention/CIntervention.h"
@@ -41,6 +42,8 @@
 #include "network/CEdge.h"
 #include "network/CNetwork.h"
 #include "network/CNode.h"
+#include "utilities/CAsyncWriter.h"
+#include "utilities/CCheckpoint.h"
 #include "utilities/CCommunicate.h"
 #include "utilities/CRandom.h"
 #include "utilities/CSimConfig.h"
@@ -68,7 +71,7 @@ bool CSimulation::validate()
   return valid;
 }
 
-bool CSimulation::run()
+bool CSimulation::initialize()
 {
   bool success = true;
   std::chrono::time_point<std::chrono::steady_clock> Start = std::chrono::steady_clock::now();
@@ -115,6 +118,9 @@ bool CSimulation::run()
   CLogger::updateTick();
   CCommunicate::memUsage();
 
+  // Post the changes early so that the transfer overlaps with writing the output.
+  CNetwork::Context.Master().beginBroadcastChanges();
+
   success &= CChanges::writeDefaultOutput();
 
   CModel::UpdateGlobalStateCounts();
@@ -131,6 +137,53 @@ bool CSimulation::run()
 
   CStatus::update("running", (100.0 * std::max((CActionQueue::getCurrentTick() - CSimConfig::getStartTick() + 1), 0)) / (CSimConfig::getEndTick() - CSimConfig::getStartTick() + 1));
 
+  success &= CCheckpoint::write();
+
+  return success;
+}
+
+bool CSimulation::restart()
+{
+  bool success = true;
+  std::chrono::time_point<std::chrono::steady_clock> Start = std::chrono::steady_clock::now();
+
+  // The action queue keeps the same offset as for a simulation started at the start tick.
+  CActionQueue::init(startTick - 1);
+  CActionQueue::setCurrentTick(CCheckpoint::getTick());
+  CChanges::setCurrentTick(CCheckpoint::getTick());
+  CLogger::updateTick();
+  CCommunicate::memUsage();
+
+  CChanges::determineNodesRequested();
+  CDependencyGraph::buildGraph();
+
+#pragma omp parallel reduction(&: success)
+  {
+    if (!CDependencyGraph::applyComputeOnceOrder())
+      success &= false;
+  }
+
+  success &= CCheckpoint::restore();
+
+  // Synchronize the restored local nodes with their remote copies.
+  CNetwork::Context.Master().beginBroadcastChanges();
+  CNetwork::Context.Master().broadcastChanges();
+
+  CLogger::info("CSimulation::restart: tick = '{}', duration = '{}' \xc2\xb5s.", CCheckpoint::getTick(), std::chrono::nanoseconds(std::chrono::steady_clock::now() - Start).count()/1000);
+
+  CStatus::update("running", (100.0 * std::max((CActionQueue::getCurrentTick() - CSimConfig::getStartTick() + 1), 0)) / (CSimConfig::getEndTick() - CSimConfig::getStartTick() + 1));
+
+  return success;
+}
+
+bool CSimulation::run()
+{
+  if (CSimConfig::getOutputWriter().asynchronous)
+    CAsyncWriter::start(CSimConfig::getOutputWriter().queueSize);
+
+  bool success = CCheckpoint::isRestart() ? restart() : initialize();
+  std::chrono::time_point<std::chrono::steady_clock> Start;
+
   while (CActionQueue::getCurrentTick() < endTick && success)
     {
 #pragma omp parallel reduction(&: success)
@@ -176,6 +229,8 @@ bool CSimulation::run()
       CLogger::updateTick();
       CCommunicate::memUsage();
 
+      CNetwork::Context.Master().beginBroadcastChanges();
+
       success &= CChanges::writeDefaultOutput();
       CModel::UpdateGlobalStateCounts();
       success &= CModel::WriteGlobalStateCounts();
@@ -197,7 +252,13 @@ bool CSimulation::run()
 #pragma omp master
         CRandom::init(found->second);
 
+      success &= CCheckpoint::write();
     }
 
+  CQueryCache::report();
+
+  // Wait for all output to be written.
+  success &= CAsyncWriter::stop();
+
   return success;
 }
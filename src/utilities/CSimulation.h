@@ -38,6 +38,10 @@ public:
   ~CSimulation();
   bool validate();
   bool run();
+
+private:
+  bool initialize();
+  bool restart();
 };
 
 #endif
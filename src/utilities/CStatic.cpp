@@ -70,18 +70,36 @@ CTick CActionQueue::CurrenTick = CTick();
 // static 
 size_t CActionQueue::TotalPendingActions = 0;
 
-// static 
-std::stringstream CActionQueue::RemoteActions = std::stringstream();
-
 // static 
 CContext< CChanges::Changes > CChanges::Context = CContext< CChanges::Changes >();
 
 // static 
 std::map< size_t, std::set< const CNode * > > CChanges::RankToNodesRequested;
 
+// static
+std::vector< size_t > CChanges::RequestOffsets;
+
+// static
+std::vector< CChanges::sRequest > CChanges::Requests;
+
+// static
+std::vector< std::vector< CChanges::sChangedNode > > CChanges::RankToChangedNodes;
+
+// static
+std::vector< std::vector< CNode * > > CChanges::RankToRemoteNodes;
+
+// static
+std::vector< int > CChanges::RanksToSend;
+
+// static
+std::vector< int > CChanges::RanksToReceive;
+
 // static
 size_t CChanges::Tick = std::numeric_limits< size_t >::max();
 
+// static
+bool CChanges::BinaryOutput = false;
+
 // static
 CConnection * CConnection::pINSTANCE = NULL;
 
@@ -196,6 +214,15 @@ size_t CCommunicate::MPIWinSize(0);
 // static
 double * CCommunicate::RMABuffer(NULL);
 
+// static
+std::vector< std::string > CCommunicate::ExchangeBuffers;
+
+// static
+std::vector< MPI_Request > CCommunicate::ExchangeRequests;
+
+// static
+const int CCommunicate::ExchangeTag(1);
+
 // static
 CRandom::CContext CRandom::G;
 
@@ -22,10 +22,12 @@
 // SOFTWARE 
 // END: Copyright 
 
+#include <cstdlib>
 #include <cstring>
 #include <jansson.h>
 
 #include "utilities/CStatus.h"
+#include "utilities/CAsyncWriter.h"
 #include "utilities/CSimConfig.h"
 #include "utilities/CArgs.h"
 #include "utilities/CDirEntry.h"
@@ -138,6 +140,15 @@ void CStatus::update(const std::string & status, const double & progress)
       json_string_set(pDetail,  (Name + ": Failed").c_str());
     }
 
+  if (CAsyncWriter::isRunning())
+    {
+      char * pDump = json_dumps(pJSON, JSON_INDENT(2));
+      CAsyncWriter::write(fileName, pDump);
+      free(pDump);
+
+      return;
+    }
+
   json_dump_file(pJSON, fileName.c_str(), JSON_INDENT(2));
 }
 
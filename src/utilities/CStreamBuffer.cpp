@@ -40,3 +40,41 @@ CStreamBuffer::CStreamBuffer(char * pBuffer, size_t size)
 CStreamBuffer::~CStreamBuffer()
 {}
 
+const char * CStreamBuffer::current() const
+{
+  return gptr();
+}
+
+// static
+void CStreamBuffer::writeVarint(std::ostream & os, size_t value)
+{
+  while (value >= 0x80)
+    {
+      os.put(static_cast< char >((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+
+  os.put(static_cast< char >(value));
+}
+
+// static
+bool CStreamBuffer::readVarint(std::istream & is, size_t & value)
+{
+  value = 0;
+
+  for (size_t shift = 0; shift < 64; shift += 7)
+    {
+      int Byte = is.get();
+
+      if (Byte == std::char_traits< char >::eof())
+        return false;
+
+      value |= static_cast< size_t >(Byte & 0x7f) << shift;
+
+      if ((Byte & 0x80) == 0)
+        return true;
+    }
+
+  return false;
+}
+
@@ -45,6 +45,27 @@ public:
   CStreamBuffer(char * pBuffer, size_t size);
 
   virtual ~CStreamBuffer();
+
+  /**
+   * Retrieve the current read position which allows random access to the unread data
+   * @return const char * pCurrent
+   */
+  const char * current() const;
+
+  /**
+   * Write the value as a variable length integer using 7 bits per byte
+   * @param std::ostream & os
+   * @param size_t value
+   */
+  static void writeVarint(std::ostream & os, size_t value);
+
+  /**
+   * Read a variable length integer written by writeVarint
+   * @param std::istream & is
+   * @param size_t & value
+   * @return bool success
+   */
+  static bool readVarint(std::istream & is, size_t & value);
 };
 
 #endif /* SRC_UTILITIES_CSTREAMBUFFER_H_ */
@@ -56,10 +56,13 @@ CVariable::CVariable()
   , mScope()
   , mInitialValue(std::numeric_limits< double >::quiet_NaN())
   , mLocalValue()
+  , mAccumulated()
   , mResetValue(0)
   , mIndex(std::numeric_limits< size_t >::max())
 {
   mLocalValue.init();
+  mAccumulated.init();
+  initAccumulated();
 }
 
 
@@ -71,6 +74,7 @@ CVariable::CVariable(const CVariable & src)
   , mScope(src.mScope)
   , mInitialValue(src.mInitialValue)
   , mLocalValue(src.mLocalValue)
+  , mAccumulated(src.mAccumulated)
   , mResetValue(src.mResetValue)
   , mIndex(src.mIndex)
 {}
@@ -83,10 +87,13 @@ CVariable::CVariable(const json_t * json)
   , mScope()
   , mInitialValue(std::numeric_limits< double >::quiet_NaN())
   , mLocalValue()
+  , mAccumulated()
   , mResetValue(0)
   , mIndex(std::numeric_limits< size_t >::max())
 {
   mLocalValue.init();
+  mAccumulated.init();
+  initAccumulated();
 
   fromJSON(json);
 
@@ -207,6 +214,37 @@ void CVariable::fromBinary(std::istream & is)
   is.read(reinterpret_cast< char * >(&mInitialValue), sizeof(double));
 }
 
+void CVariable::toCheckpoint(std::ostream & os) const
+{
+  os.write(reinterpret_cast< const char * >(&mLocalValue.Master()), sizeof(double));
+
+  const double * pIt = mLocalValue.beginThread();
+  const double * pEnd = mLocalValue.endThread();
+
+  if (mLocalValue.isThread(pIt))
+    for (; pIt != pEnd; ++pIt)
+      os.write(reinterpret_cast< const char * >(pIt), sizeof(double));
+}
+
+void CVariable::fromCheckpoint(std::istream & is)
+{
+  is.read(reinterpret_cast< char * >(&mLocalValue.Master()), sizeof(double));
+
+  double * pIt = mLocalValue.beginThread();
+  double * pEnd = mLocalValue.endThread();
+
+  if (mLocalValue.isThread(pIt))
+    for (; pIt != pEnd; ++pIt)
+      is.read(reinterpret_cast< char * >(pIt), sizeof(double));
+
+  if (CCommunicate::MPIRank == 0
+      && mScope == Scope::global
+      && CCommunicate::MPIProcesses > 1)
+    {
+      CCommunicate::updateRMA(mIndex, &CValueInterface::equal, mLocalValue.Master());
+    }
+}
+
 const std::string & CVariable::getId() const
 {
   return mId;
@@ -290,7 +328,18 @@ bool CVariable::setValue(const CValueInterface & value, CValueInterface::pOperat
 
   if (mScope == Scope::global
       && CCommunicate::MPIProcesses > 1)
-    Value = CCommunicate::updateRMA(mIndex, pOperator, OperatorValue);
+    {
+      if (accumulate(pOperator, OperatorValue))
+        {
+          // The local value reflects local changes until the next synchronization.
+          (*pOperator)(Value, OperatorValue);
+        }
+      else
+        {
+          flushAccumulated(mAccumulated.Active());
+          Value = CCommunicate::updateRMA(mIndex, pOperator, OperatorValue);
+        }
+    }
   else
     (*pOperator)(Value, OperatorValue);
 
@@ -302,6 +351,83 @@ bool CVariable::setValue(const CValueInterface & value, CValueInterface::pOperat
   return changed;
 }
 
+bool CVariable::accumulate(CValueInterface::pOperator pOperator, const double & value)
+{
+  CCommunicate::Accumulation Accumulation;
+  double Value = value;
+
+  if (pOperator == &CValueInterface::plus)
+    Accumulation = CCommunicate::Accumulation::Sum;
+  else if (pOperator == &CValueInterface::minus)
+    {
+      Accumulation = CCommunicate::Accumulation::Sum;
+      Value = -value;
+    }
+  else if (pOperator == &CValueInterface::multiply)
+    Accumulation = CCommunicate::Accumulation::Product;
+  else
+    return false;
+
+  sAccumulated & Accumulated = mAccumulated.Active();
+
+  // Sums and products do not commute with each other
+  if (Accumulated.pending
+      && Accumulated.accumulation != Accumulation)
+    flushAccumulated(Accumulated);
+
+  if (Accumulated.pending)
+    {
+      if (Accumulation == CCommunicate::Accumulation::Sum)
+        Accumulated.value += Value;
+      else
+        Accumulated.value *= Value;
+    }
+  else
+    {
+      Accumulated.pending = true;
+      Accumulated.accumulation = Accumulation;
+      Accumulated.value = Value;
+    }
+
+  return true;
+}
+
+void CVariable::flushAccumulated(CVariable::sAccumulated & accumulated)
+{
+  if (!accumulated.pending)
+    return;
+
+  CCommunicate::accumulateRMA(mIndex, accumulated.accumulation, accumulated.value);
+  accumulated.pending = false;
+}
+
+void CVariable::flushAccumulated()
+{
+  if (mScope != Scope::global
+      || CCommunicate::MPIProcesses == 1)
+    return;
+
+  flushAccumulated(mAccumulated.Master());
+
+  sAccumulated * pIt = mAccumulated.beginThread();
+  sAccumulated * pEnd = mAccumulated.endThread();
+
+  if (mAccumulated.isThread(pIt))
+    for (; pIt != pEnd; ++pIt)
+      flushAccumulated(*pIt);
+}
+
+void CVariable::initAccumulated()
+{
+  mAccumulated.Master().pending = false;
+
+  sAccumulated * pIt = mAccumulated.beginThread();
+  sAccumulated * pEnd = mAccumulated.endThread();
+
+  for (; pIt != pEnd; ++pIt)
+    pIt->pending = false;
+}
+
 void CVariable::updateMaster()
 {
   mLocalValue.Master() = mLocalValue.Active();
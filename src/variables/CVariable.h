@@ -29,6 +29,7 @@
 #include "math/CValueInterface.h"
 
 #include "utilities/CAnnotation.h"
+#include "utilities/CCommunicate.h"
 #include "utilities/CContext.h"
 
 class CValue;
@@ -60,6 +61,18 @@ public:
 
   void fromBinary(std::istream & is);
 
+  /**
+   * Write the current master and thread values to a checkpoint
+   * @param std::ostream & os
+   */
+  void toCheckpoint(std::ostream & os) const;
+
+  /**
+   * Restore the current master and thread values from a checkpoint
+   * @param std::istream & is
+   */
+  void fromCheckpoint(std::istream & is);
+
   const std::string & getId() const;
 
   const Scope & getScope() const;
@@ -68,8 +81,27 @@ public:
 
   bool getValue();
 
+  /**
+   * Apply the operator with the given value to the variable and return whether its value changed.
+   * For global variables in multi process runs sums, differences, and products are accumulated
+   * and only applied to the global value by flushAccumulated. In that case the returned flag and
+   * the change tracking reflect the local value, i.e., the effect of this update alone. Changes made
+   * by other processes are detected when the global value is retrieved during synchronization
+   * (see CVariableList::synchronizeChangedVariables). All other operators are applied to the global
+   * value immediately and the returned global value is compared against the previous local value.
+   * @param const CValueInterface & value
+   * @param CValueInterface::pOperator pOperator
+   * @param const CMetadata & metadata
+   * @return bool changed
+   */
   bool setValue(const CValueInterface & value, CValueInterface::pOperator pOperator, const CMetadata & metadata);
 
+  /**
+   * Apply the commutative updates of global variables accumulated by all threads to the
+   * global value. This must be called by a single thread prior to synchronizing the values.
+   */
+  void flushAccumulated();
+
   void updateMaster();
 
   void setInitialValue(const double & initialValue);
@@ -94,12 +126,29 @@ protected:
    */
 
 private:
+  /**
+   * Commutative updates of a global variable not yet applied to the global value
+   */
+  struct sAccumulated
+  {
+    bool pending;
+    CCommunicate::Accumulation accumulation;
+    double value;
+  };
+
   bool setValue(double value, CValueInterface::pOperator pOperator, const CMetadata & metadata);
 
+  bool accumulate(CValueInterface::pOperator pOperator, const double & value);
+
+  void flushAccumulated(sAccumulated & accumulated);
+
+  void initAccumulated();
+
   std::string mId;
   Scope mScope;
   double mInitialValue;
   CContext< double > mLocalValue;
+  CContext< sAccumulated > mAccumulated;
   int mResetValue;
   size_t mIndex;
 };
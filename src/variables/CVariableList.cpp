@@ -124,6 +124,41 @@ void CVariableList::fromBinary(std::istream & is)
     }
 }
 
+void CVariableList::toCheckpoint(std::ostream & os) const
+{
+  size_t Size = size();
+
+  os.write(reinterpret_cast<const char *>(&Size), sizeof(size_t));
+
+  const_iterator it = begin();
+  const_iterator itEnd = end();
+
+  for (; it != itEnd; ++it)
+    {
+      (*it)->toCheckpoint(os);
+    }
+}
+
+bool CVariableList::fromCheckpoint(std::istream & is)
+{
+  size_t Size;
+
+  is.read(reinterpret_cast<char *>(&Size), sizeof(size_t));
+
+  if (is.fail() || Size != size())
+    return false;
+
+  base::iterator it = base::begin();
+  base::iterator itEnd = base::end();
+
+  for (; it != itEnd; ++it)
+    {
+      (*it)->fromCheckpoint(is);
+    }
+
+  return !is.fail();
+}
+
 CVariable & CVariableList::operator[](const size_t & index)
 {
   if (index < size())
@@ -182,6 +217,7 @@ void CVariableList::resetAll(const bool & force)
   if (INSTANCE.mChangedVariables.isThread(&Active))
     Active.clear();
 
+  flushAccumulated();
   CCommunicate::barrierRMA();
 
 #pragma omp single
@@ -200,8 +236,24 @@ void CVariableList::resetAll(const bool & force)
   }
 }
 
+void CVariableList::flushAccumulated()
+{
+  // All threads must have completed their updates before they are flushed.
+#pragma omp barrier
+
+#pragma omp single
+  {
+    base::iterator it = base::begin();
+    base::iterator end = base::end();
+
+    for (; it != end; ++it)
+      (*it)->flushAccumulated();
+  }
+}
+
 void CVariableList::synchronizeChangedVariables()
 {
+  flushAccumulated();
   CCommunicate::barrierRMA();
 
 #pragma omp single
@@ -63,6 +63,10 @@ public:
 
   void fromBinary(std::istream & is);
 
+  void toCheckpoint(std::ostream & os) const;
+
+  bool fromCheckpoint(std::istream & is);
+
   CVariable & operator[](const size_t & id);
 
   CVariable & operator[](const std::string & id);
@@ -73,6 +77,12 @@ public:
 
   void synchronizeChangedVariables();
 
+  /**
+   * Apply the accumulated commutative updates of all global variables. This must be called
+   * by all threads.
+   */
+  void flushAccumulated();
+
   bool append(CVariable * pVariable);
 
   const_iterator begin() const;
@@ -0,0 +1,92 @@
+#include "catch.hpp"
+
+#include "actions/CActionCalendar.h"
+#include "actions/CActionDefinition.h"
+
+extern void clearTest();
+
+class CCalendarTestAction : public CAction
+{
+public:
+  CCalendarTestAction()
+    : CAction()
+  {}
+
+  virtual size_t getOrder() const
+  {
+    return 0;
+  }
+
+  virtual bool execute() const
+  {
+    return true;
+  }
+
+  virtual void toBinary(std::ostream & /* os */) const
+  {}
+};
+
+static void schedule(CActionCalendar & calendar, const size_t & tick, const size_t & count)
+{
+  for (size_t i = 0; i < count; ++i)
+    calendar.at(tick).addAction(new CCalendarTestAction());
+}
+
+TEST_CASE("Action calendar wraps into the overflow", "[EpiHiper]")
+{
+  clearTest();
+
+  // Actions are stored by their order which requires at least the default priority.
+  CActionDefinition::convertPrioritiesToOrder();
+
+  const size_t & Horizon = CActionCalendar::Horizon;
+  CActionCalendar Calendar;
+
+  // Ticks which map to the same slot of the ring
+  size_t Tick = 5;
+  size_t Next = Tick + Horizon;
+  size_t Far = Tick + 3 * Horizon;
+
+  schedule(Calendar, Tick, 1);
+  schedule(Calendar, Next, 2);
+  schedule(Calendar, Far, 3);
+
+  REQUIRE(Calendar.size(Tick) == 1);
+  REQUIRE(Calendar.size(Next) == 2);
+  REQUIRE(Calendar.size(Far) == 3);
+  REQUIRE(Calendar.size(Tick + 2 * Horizon) == 0);
+
+  // Processing the tick leaves its slot free for the next wrap around.
+  CCurrentActions * pActions = Calendar.take(Tick);
+  REQUIRE(pActions->size() == 1);
+  REQUIRE(Calendar.size(Tick) == 0);
+  Calendar.recycle(pActions);
+
+  // Advancing moves the next tick from the overflow into the ring.
+  Calendar.advance(Tick + 1);
+  REQUIRE(Calendar.size(Next) == 2);
+  REQUIRE(Calendar.size(Far) == 3);
+
+  // Actions added to a tick now in the ring are kept with the moved ones.
+  schedule(Calendar, Next, 1);
+  REQUIRE(Calendar.size(Next) == 3);
+
+  // A tick in the same slot which passed without being processed is replaced.
+  Calendar.advance(Next + Horizon);
+  REQUIRE(Calendar.size(Next) == 3);
+  schedule(Calendar, Next + Horizon, 4);
+  REQUIRE(Calendar.size(Next + Horizon) == 4);
+  REQUIRE(Calendar.size(Next) == 0);
+
+  // The far tick reaches the ring at the end of the horizon.
+  REQUIRE(Calendar.size(Far) == 3);
+  Calendar.advance(Far - Horizon + 1);
+  REQUIRE(Calendar.size(Far) == 3);
+
+  pActions = Calendar.take(Far);
+  REQUIRE(pActions->size() == 3);
+  REQUIRE(Calendar.size(Far) == 0);
+  Calendar.recycle(pActions);
+
+  clearTest();
+}
@@ -0,0 +1,90 @@
+#include "catch.hpp"
+
+#include "actions/CAction.h"
+
+extern void clearTest();
+
+class CTestAction : public CAction
+{
+public:
+  CTestAction()
+    : CAction()
+    , mOrder(0)
+  {}
+
+  virtual size_t getOrder() const
+  {
+    return mOrder;
+  }
+
+  virtual bool execute() const
+  {
+    return true;
+  }
+
+  virtual void toBinary(std::ostream & /* os */) const
+  {}
+
+private:
+  size_t mOrder;
+};
+
+TEST_CASE("Action pool cross thread release", "[EpiHiper]")
+{
+  clearTest();
+
+#ifdef USE_OMP
+  int MaxThreads = omp_get_max_threads();
+
+  if (MaxThreads < 2)
+    omp_set_num_threads(2);
+#endif // USE_OMP
+
+  CAction::initPools();
+
+  const size_t Actions = 10000;
+  const size_t Rounds = 10;
+  std::vector< CAction * > Scheduled(Actions, NULL);
+
+  size_t Live = 0;
+  size_t Allocations = 0;
+  size_t Reserved = 0;
+  size_t FirstReserved = 0;
+
+  for (size_t Round = 0; Round < Rounds; ++Round)
+    {
+#pragma omp parallel num_threads(2)
+      {
+        // The first thread allocates the actions and the second one destroys them.
+        if (omp_get_thread_num() == 0)
+          for (size_t i = 0; i < Actions; ++i)
+            Scheduled[i] = new CTestAction();
+
+#pragma omp barrier
+
+        if (omp_get_thread_num() == 1
+            || omp_get_num_threads() == 1)
+          for (size_t i = 0; i < Actions; ++i)
+            delete Scheduled[i];
+      }
+
+      CAction::poolUsage(Live, Allocations, Reserved);
+
+      REQUIRE(Live == 0);
+      REQUIRE(Allocations == (Round + 1) * Actions);
+
+      if (Round == 0)
+        FirstReserved = Reserved;
+    }
+
+  // The released memory must be reused by the allocating thread.
+  REQUIRE(Reserved == FirstReserved);
+
+  CAction::releasePools();
+
+#ifdef USE_OMP
+  omp_set_num_threads(MaxThreads);
+#endif // USE_OMP
+
+  clearTest();
+}
@@ -0,0 +1,78 @@
+#include "catch.hpp"
+
+#include <sstream>
+
+#include "utilities/CCheckpoint.h"
+#include "utilities/CLogger.h"
+#include "utilities/CRandom.h"
+#include "utilities/CMetadata.h"
+#include "diseaseModel/CModel.h"
+#include "diseaseModel/CHealthState.h"
+
+extern std::string getAbsolutePath(const std::string & fileName);
+extern void clearTest();
+
+TEST_CASE("Checkpoint rank round trip", "[EpiHiper]")
+{
+  clearTest();
+
+  CRandom::result_t Seed = CRandom::getSeed();
+
+#ifdef USE_OMP
+  int MaxThreads = omp_get_max_threads();
+
+  // The master generator is distinct from the thread generators when there is more than one thread.
+  omp_set_num_threads(2);
+#endif // USE_OMP
+
+  CRandom::G.release();
+  CRandom::G.init();
+  CRandom::seed(Seed);
+
+  CModel::Load(getAbsolutePath("example/diseaseModel.json"));
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  CMetadata Info("Test", true);
+  CHealthState * pState = CModel::GetState("S");
+  REQUIRE(pState != NULL);
+  REQUIRE(pState->setSusceptibility(0.25, &CValueInterface::equal, Info));
+
+  // Advance all generators differently.
+  CRandom::G.Master().discard(3);
+
+  CRandom::generator_t * pIt = CRandom::G.beginThread();
+  CRandom::generator_t * pEnd = CRandom::G.endThread();
+
+  for (size_t i = 1; pIt != pEnd; ++pIt, ++i)
+    pIt->discard(5 * i);
+
+  CRandom::generator_t Master = CRandom::G.Master();
+  std::vector< CRandom::generator_t > Threads(CRandom::G.beginThread(), CRandom::G.endThread());
+
+  std::stringstream Checkpoint;
+  REQUIRE(CCheckpoint::writeRank(Checkpoint));
+
+  // Modify the state after the checkpoint.
+  REQUIRE(pState->setSusceptibility(1.0, &CValueInterface::equal, Info));
+  CRandom::G.Master().discard(7);
+
+  for (pIt = CRandom::G.beginThread(); pIt != pEnd; ++pIt)
+    pIt->discard(11);
+
+  REQUIRE(CCheckpoint::readRank(Checkpoint));
+
+  REQUIRE(pState->getSusceptibility() == 0.25);
+  REQUIRE(CRandom::G.Master() == Master);
+  REQUIRE(std::equal(Threads.begin(), Threads.end(), CRandom::G.beginThread()));
+
+  clearTest();
+
+  CRandom::G.release();
+
+#ifdef USE_OMP
+  omp_set_num_threads(MaxThreads);
+#endif // USE_OMP
+
+  CRandom::G.init();
+  CRandom::seed(Seed);
+}
@@ -0,0 +1,185 @@
+#include "catch.hpp"
+
+#include <limits>
+#include <sstream>
+
+#include "diseaseModel/CModel.h"
+#include "diseaseModel/CHealthState.h"
+#include "network/CNetwork.h"
+#include "network/CNode.h"
+#include "utilities/CLogger.h"
+#include "utilities/CStreamBuffer.h"
+
+extern std::string getAbsolutePath(const std::string & fileName);
+extern void clearTest();
+
+static const unsigned char Fields[] = {CNode::HealthStateField,
+                                       CNode::SusceptibilityFactorField,
+                                       CNode::SusceptibilityField,
+                                       CNode::InfectivityFactorField,
+                                       CNode::InfectivityField,
+                                       CNode::NodeTraitField,
+                                       CNode::AllFields};
+
+// A node with distinct values in all fields of the binary data
+static void setFields(CNode & node, const size_t & healthState, const double & value)
+{
+  node.healthState = healthState;
+  node.susceptibilityFactor = value + 0.1;
+  node.susceptibility = value + 0.2;
+  node.infectivityFactor = value + 0.3;
+  node.infectivity = value + 0.4;
+  node.nodeTrait = static_cast< CTraitData::base >(1000 * value) + 5;
+}
+
+// Fields included in the mask must match the changed node, all others the original node.
+static void checkFields(const CNode & node, const CNode & changed, const CNode & original, const unsigned char & fields)
+{
+  REQUIRE(node.healthState == ((fields & CNode::HealthStateField) ? changed : original).healthState);
+  REQUIRE(node.susceptibilityFactor == ((fields & CNode::SusceptibilityFactorField) ? changed : original).susceptibilityFactor);
+  REQUIRE(node.susceptibility == ((fields & CNode::SusceptibilityField) ? changed : original).susceptibility);
+  REQUIRE(node.infectivityFactor == ((fields & CNode::InfectivityFactorField) ? changed : original).infectivityFactor);
+  REQUIRE(node.infectivity == ((fields & CNode::InfectivityField) ? changed : original).infectivity);
+  REQUIRE(node.nodeTrait == ((fields & CNode::NodeTraitField) ? changed : original).nodeTrait);
+}
+
+// Write a block in the same way as CChanges::sendNodesRequested, i.e., the node count and size
+// followed by the delta encoded indexes and the compact binary data of each node.
+static void writeBlock(std::ostream & os, const std::vector< std::pair< size_t, const CNode * > > & nodes)
+{
+  std::ostringstream Block;
+  size_t PreviousIndex = 0;
+
+  for (const std::pair< size_t, const CNode * > & Node : nodes)
+    {
+      CStreamBuffer::writeVarint(Block, Node.first - PreviousIndex);
+      Node.second->toCompactBinary(Block);
+      PreviousIndex = Node.first;
+    }
+
+  CStreamBuffer::writeVarint(os, nodes.size());
+  CStreamBuffer::writeVarint(os, Block.str().size());
+  os << Block.str();
+}
+
+TEST_CASE("Variable length integers", "[EpiHiper]")
+{
+  clearTest();
+
+  const size_t Max = std::numeric_limits< size_t >::max();
+  std::vector< std::pair< size_t, size_t > > Values = {{0, 1}, {1, 1}, {127, 1}, {128, 2}, {16383, 2}, {16384, 3}, {size_t(1) << 32, 5}, {Max, 10}};
+  std::stringstream Stream;
+
+  for (const std::pair< size_t, size_t > & Value : Values)
+    {
+      std::streamoff Begin = Stream.tellp();
+      CStreamBuffer::writeVarint(Stream, Value.first);
+      REQUIRE(Stream.tellp() - Begin == (std::streamoff) Value.second);
+    }
+
+  size_t Value;
+
+  for (const std::pair< size_t, size_t > & Expected : Values)
+    {
+      REQUIRE(CStreamBuffer::readVarint(Stream, Value));
+      REQUIRE(Value == Expected.first);
+    }
+
+  REQUIRE_FALSE(CStreamBuffer::readVarint(Stream, Value));
+
+  // A value which is truncated after a byte with the continuation bit
+  std::istringstream Truncated(std::string(1, static_cast< char >(0x80)));
+  REQUIRE_FALSE(CStreamBuffer::readVarint(Truncated, Value));
+
+  clearTest();
+}
+
+TEST_CASE("Compact node binary round trip", "[EpiHiper]")
+{
+  clearTest();
+
+  CNode Changed;
+  // A health state which requires a multi-byte variable length integer
+  setFields(Changed, 300, 1.0);
+
+  CNode Original;
+  setFields(Original, 2, 5.0);
+
+  for (const unsigned char & Mask : Fields)
+    {
+      Changed.changedFields = Mask;
+
+      std::stringstream Stream;
+      Changed.toCompactBinary(Stream);
+
+      CNode Node;
+      setFields(Node, Original.healthState, 5.0);
+
+      REQUIRE(Node.fromCompactBinary(Stream) == Mask);
+      checkFields(Node, Changed, Original, Mask);
+
+      // All data written has been read.
+      REQUIRE(Stream.peek() == std::char_traits< char >::eof());
+    }
+
+  clearTest();
+}
+
+TEST_CASE("Compact node exchange round trip", "[EpiHiper]")
+{
+  clearTest();
+
+  CModel::Load(getAbsolutePath("example/diseaseModel.json"));
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  // The remote nodes are updated as seen from the master of an empty network.
+  CNetwork::Context.init();
+
+  const CHealthState * pOriginalState = CModel::GetState("S");
+  const CHealthState * pChangedState = CModel::GetState("I");
+  REQUIRE(pOriginalState != NULL);
+  REQUIRE(pChangedState != NULL);
+
+  CNode Original;
+  setFields(Original, pOriginalState->getIndex(), 5.0);
+
+  // One changed node for each field and one with all fields
+  const size_t Size = sizeof(Fields) / sizeof(Fields[0]);
+  std::vector< CNode > Changed(Size);
+  std::vector< CNode > Nodes(Size);
+
+  for (size_t i = 0; i < Size; ++i)
+    {
+      setFields(Changed[i], pChangedState->getIndex(), 10.0 + i);
+      Changed[i].changedFields = Fields[i];
+
+      Nodes[i].setHealthState(pOriginalState);
+      setFields(Nodes[i], pOriginalState->getIndex(), 5.0);
+    }
+
+  // Indexes with deltas which require one, two, and three bytes. The remaining remote nodes are unknown.
+  std::vector< size_t > Indexes = {3, 200, 16583, 17000, 17001, 40000, 69999};
+  std::vector< CNode * > RemoteNodes(70000, NULL);
+
+  for (size_t i = 0; i < Size; ++i)
+    RemoteNodes[Indexes[i]] = &Nodes[i];
+
+  // The sender's threads write separate blocks with the indexes delta encoded within each block.
+  std::ostringstream Stream;
+  writeBlock(Stream, {{Indexes[0], &Changed[0]}, {Indexes[1], &Changed[1]}, {Indexes[2], &Changed[2]}});
+  writeBlock(Stream, {{Indexes[3], &Changed[3]}, {Indexes[4], &Changed[4]}});
+  writeBlock(Stream, {{Indexes[5], &Changed[5]}, {Indexes[6], &Changed[6]}});
+
+  const std::string Data = Stream.str();
+
+  REQUIRE(CNetwork::receiveCompactNodes(Data.c_str(), Data.size(), RemoteNodes, 1) == CCommunicate::ErrorCode::Success);
+  REQUIRE_FALSE(CLogger::hasErrors());
+
+  for (size_t i = 0; i < Size; ++i)
+    {
+      checkFields(Nodes[i], Changed[i], Original, Fields[i]);
+      REQUIRE(Nodes[i].getHealthState() == ((Fields[i] & CNode::HealthStateField) ? pChangedState : pOriginalState));
+    }
+
+  clearTest();
+}
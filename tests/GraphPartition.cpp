@@ -0,0 +1,86 @@
+#include "catch.hpp"
+
+#include <algorithm>
+
+#include "network/CGraphPartition.h"
+
+extern void clearTest();
+
+// A star where the hub has an edge to and from each leaf, i.e., all leaves prefer the hub's part.
+static void createStar(const size_t & leaves, std::vector< size_t > & inOffsets, std::vector< size_t > & sources)
+{
+  inOffsets.assign(1, 0);
+  sources.clear();
+
+  for (size_t Leaf = 1; Leaf <= leaves; ++Leaf)
+    sources.push_back(Leaf);
+
+  inOffsets.push_back(sources.size());
+
+  for (size_t Leaf = 1; Leaf <= leaves; ++Leaf)
+    {
+      sources.push_back(0);
+      inOffsets.push_back(sources.size());
+    }
+}
+
+TEST_CASE("Graph partition keeps all parts non empty", "[EpiHiper]")
+{
+  clearTest();
+
+  std::vector< size_t > InOffsets;
+  std::vector< size_t > Sources;
+  createStar(20, InOffsets, Sources);
+
+  const int Parts = 4;
+  size_t Nodes = InOffsets.size() - 1;
+
+  // A large imbalance lets label propagation move all leaves to the part of the hub.
+  CGraphPartition Graph(InOffsets, Sources);
+  std::vector< int > Partition = Graph.partition(Parts, 10.0);
+
+  REQUIRE(Partition.size() == Nodes);
+
+  std::vector< std::vector< size_t > > PartNodes(Parts);
+
+  for (size_t Node = 0; Node < Nodes; ++Node)
+    {
+      REQUIRE(Partition[Node] >= 0);
+      REQUIRE(Partition[Node] < Parts);
+      PartNodes[Partition[Node]].push_back(Node);
+    }
+
+  for (int Part = 0; Part < Parts; ++Part)
+    {
+      REQUIRE(!PartNodes[Part].empty());
+
+      // Reordering must be a permutation of the nodes of the part.
+      std::vector< size_t > Reordered(PartNodes[Part]);
+      Graph.reorder(Reordered);
+      std::sort(Reordered.begin(), Reordered.end());
+
+      REQUIRE(Reordered == PartNodes[Part]);
+    }
+
+  clearTest();
+}
+
+TEST_CASE("Graph partition with as many parts as nodes", "[EpiHiper]")
+{
+  clearTest();
+
+  std::vector< size_t > InOffsets;
+  std::vector< size_t > Sources;
+  createStar(3, InOffsets, Sources);
+
+  // The hub carries most of the edges, which must not leave the remaining parts empty.
+  CGraphPartition Graph(InOffsets, Sources);
+  std::vector< int > Partition = Graph.partition(4, 0.05);
+
+  std::vector< int > Sorted(Partition);
+  std::sort(Sorted.begin(), Sorted.end());
+
+  REQUIRE(Sorted == std::vector< int >({0, 1, 2, 3}));
+
+  clearTest();
+}
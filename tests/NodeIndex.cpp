@@ -0,0 +1,87 @@
+#include "catch.hpp"
+
+#include <limits>
+
+#include "network/CNodeIndex.h"
+#include "network/CNode.h"
+
+extern void clearTest();
+
+static void checkIndex(const CNodeIndex & index,
+                       std::vector< CNode > & local,
+                       const std::vector< std::pair< size_t, CNode * > > & remote,
+                       const std::vector< size_t > & unknown)
+{
+  REQUIRE(index.isValid());
+
+  for (CNode & Node : local)
+    if (Node.id != std::numeric_limits< size_t >::max())
+      REQUIRE(index.lookup(Node.id) == &Node);
+
+  for (const std::pair< size_t, CNode * > & Remote : remote)
+    REQUIRE(index.lookup(Remote.first) == Remote.second);
+
+  for (const size_t & Id : unknown)
+    REQUIRE(index.lookup(Id) == NULL);
+}
+
+TEST_CASE("Node index with direct addressing", "[EpiHiper]")
+{
+  clearTest();
+
+  // Every other id of [100, 200) is local, which is dense enough for direct addressing.
+  std::vector< CNode > Local(50);
+
+  for (size_t i = 0; i < Local.size(); ++i)
+    Local[i].id = 100 + 2 * i;
+
+  std::vector< CNode > Remote(3);
+  std::vector< std::pair< size_t, CNode * > > RemoteNodes = {{5, &Remote[0]}, {1000, &Remote[1]}, {size_t(1) << 40, &Remote[2]}};
+
+  CNodeIndex Index;
+  Index.init(Local.data(), Local.data() + Local.size(), RemoteNodes);
+
+  // Ids below, between, and beyond the local ids
+  checkIndex(Index, Local, RemoteNodes, {0, 4, 99, 101, 197, 199, 200, 1001, (size_t(1) << 40) + 1});
+
+  Index.clear();
+  REQUIRE_FALSE(Index.isValid());
+  REQUIRE(Index.lookup(100) == NULL);
+
+  clearTest();
+}
+
+TEST_CASE("Node index with hashing", "[EpiHiper]")
+{
+  clearTest();
+
+  // Sparse local ids are hashed together with the remote nodes.
+  std::vector< CNode > Local(1000);
+
+  for (size_t i = 0; i < Local.size(); ++i)
+    Local[i].id = 1000 * i + 7;
+
+  // Unused trailing nodes are ignored.
+  for (size_t i = 990; i < Local.size(); ++i)
+    Local[i].id = std::numeric_limits< size_t >::max();
+
+  // Ids which are multiples of a power of two are prone to collisions.
+  std::vector< CNode > Remote(256);
+  std::vector< std::pair< size_t, CNode * > > RemoteNodes;
+
+  for (size_t i = 0; i < Remote.size(); ++i)
+    RemoteNodes.push_back(std::make_pair((i + 1) << 32, &Remote[i]));
+
+  CNodeIndex Index;
+  Index.init(Local.data(), Local.data() + Local.size(), RemoteNodes);
+
+  std::vector< size_t > Unknown = {0, 6, 8, 1006, 990007, 999007, size_t(257) << 32, (size_t(1) << 32) + 1};
+  checkIndex(Index, Local, RemoteNodes, Unknown);
+
+  // Only remote nodes
+  std::vector< CNode > None;
+  Index.init(None.data(), None.data(), RemoteNodes);
+  checkIndex(Index, None, RemoteNodes, {7, 1007});
+
+  clearTest();
+}
@@ -0,0 +1,126 @@
+#include "catch.hpp"
+
+#include <limits>
+#include <sstream>
+
+#include "actions/CTransitionBlock.h"
+
+extern void clearTest();
+
+// Convert the binary output to CSV in the same way as EpiHiperOutputConverter.
+static bool convert(std::istream & is, std::ostream & os)
+{
+  std::vector< std::string > States;
+  bool HasLocationId;
+
+  if (!CTransitionBlock::readHeader(is, States, HasLocationId))
+    return false;
+
+  CTransitionBlock::writeCSVHeader(os, HasLocationId);
+
+  CTransitionBlock Block;
+
+  while (is.peek() != std::char_traits< char >::eof())
+    {
+      if (!Block.read(is, HasLocationId))
+        return false;
+
+      Block.toCSV(os, States, HasLocationId);
+    }
+
+  return true;
+}
+
+static void roundTrip(bool hasLocationId)
+{
+  static const size_t Missing = std::numeric_limits< size_t >::max();
+
+  std::vector< std::string > States = {"S", "E", "I", "R"};
+  std::stringstream Binary;
+  std::ostringstream Expected;
+
+  REQUIRE(CTransitionBlock::writeHeader(Binary, States, hasLocationId));
+  CTransitionBlock::writeCSVHeader(Expected, hasLocationId);
+
+  CTransitionBlock Block;
+
+  // A small block with missing contacts and locations followed by a large block
+  for (size_t Records : {3, 10000})
+    {
+      for (size_t i = 0; i < Records; ++i)
+        {
+          int Tick = i / 100 - 1;
+          size_t Pid = 1000000000000 + 7 * i;
+          size_t State = i % States.size();
+          size_t Contact = (i % 3 == 0) ? Missing : Pid + 1;
+          size_t Location = (i % 5 == 0) ? Missing : 42 + i;
+
+          Block.append(Tick, Pid, State, Contact, Location);
+
+          Expected << Tick << "," << Pid << "," << States[State] << ",";
+
+          if (Contact != Missing)
+            Expected << Contact;
+          else
+            Expected << -1;
+
+          if (hasLocationId)
+            {
+              if (Location != Missing)
+                Expected << "," << Location;
+              else
+                Expected << "," << -1;
+            }
+
+          Expected << "\n";
+        }
+
+      REQUIRE(Block.size() == Records);
+      Block.write(Binary, hasLocationId);
+      Block.clear();
+    }
+
+  // Empty blocks are not written.
+  Block.write(Binary, hasLocationId);
+
+  std::ostringstream CSV;
+  REQUIRE(convert(Binary, CSV));
+  REQUIRE(CSV.str() == Expected.str());
+}
+
+TEST_CASE("Binary transition output round trip", "[EpiHiper]")
+{
+  clearTest();
+
+  roundTrip(true);
+  roundTrip(false);
+
+  clearTest();
+}
+
+TEST_CASE("Binary transition output rejects invalid data", "[EpiHiper]")
+{
+  clearTest();
+
+  std::vector< std::string > States;
+  bool HasLocationId;
+
+  std::istringstream Invalid("tick,pid,exit_state,contact_pid\n");
+  REQUIRE_FALSE(CTransitionBlock::readHeader(Invalid, States, HasLocationId));
+
+  // A truncated block
+  std::stringstream Binary;
+  REQUIRE(CTransitionBlock::writeHeader(Binary, {"S", "I"}, false));
+
+  CTransitionBlock Block;
+  Block.append(1, 2, 1, 3, 0);
+  Block.write(Binary, false);
+
+  std::string Data = Binary.str();
+  std::istringstream Truncated(Data.substr(0, Data.size() - 4));
+  std::ostringstream CSV;
+
+  REQUIRE_FALSE(convert(Truncated, CSV));
+
+  clearTest();
+}